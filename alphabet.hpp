@@ -0,0 +1,93 @@
+/**
+* \file alphabet.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Alphabet policies for BasicTrie
+*
+*/
+
+// include gaurds
+#ifndef ALPHABET_HPP_INCLUDED
+#define ALPHABET_HPP_INCLUDED 1
+
+#include <cstddef>
+
+/// An alphabet policy maps the chars a trie can hold to STEPS symbols
+///  each, and every symbol to a dense index 0 to SIZE - 1. Each symbol
+///  takes one level of the trie. It provides:
+///   SIZE                      amount of symbols. 1 to 256
+///   STEPS                     symbols per char
+///   index(char, step)         index of symbol step of a char. SIZE if the
+///                              char is not in the alphabet
+///   symbol(char, step, index) the char with symbol step set to index
+///  Indices must keep the (unsigned) order of the chars so words still
+///  come out sorted
+
+/// Every byte. The default alphabet
+struct ByteAlphabet {
+	static const size_t SIZE = 256;
+	static const size_t STEPS = 1;
+
+	static constexpr size_t index(char c, size_t)
+	{
+		return static_cast<unsigned char>(c);
+	}
+
+	static constexpr char symbol(char, size_t, size_t index)
+	{
+		return static_cast<char>(index);
+	}
+};
+
+/// Lowercase letters a to z
+struct LowerAsciiAlphabet {
+	static const size_t SIZE = 26;
+	static const size_t STEPS = 1;
+
+	static constexpr size_t index(char c, size_t)
+	{
+		return (c >= 'a' && c <= 'z') ? static_cast<size_t>(c - 'a') : SIZE;
+	}
+
+	static constexpr char symbol(char, size_t, size_t index)
+	{
+		return static_cast<char>('a' + index);
+	}
+};
+
+/// Decimal digits 0 to 9
+struct DigitAlphabet {
+	static const size_t SIZE = 10;
+	static const size_t STEPS = 1;
+
+	static constexpr size_t index(char c, size_t)
+	{
+		return (c >= '0' && c <= '9') ? static_cast<size_t>(c - '0') : SIZE;
+	}
+
+	static constexpr char symbol(char, size_t, size_t index)
+	{
+		return static_cast<char>('0' + index);
+	}
+};
+
+/// Every byte, split into its high then its low 4 bits. Nodes have at
+///  most 16 children, so binary and UTF-8 keys get small fixed size
+///  arrays instead of 256 slot ones, at the cost of twice the depth
+struct NibbleAlphabet {
+	static const size_t SIZE = 16;
+	static const size_t STEPS = 2;
+
+	static constexpr size_t index(char c, size_t step)
+	{
+		return (step == 0) ? static_cast<unsigned char>(c) >> 4 : static_cast<unsigned char>(c) & 0xf;
+	}
+
+	static constexpr char symbol(char c, size_t step, size_t index)
+	{
+		return static_cast<char>((step == 0) ? index << 4 : (static_cast<unsigned char>(c) | index));
+	}
+};
+
+#endif
@@ -0,0 +1,682 @@
+/**
+* \file benchmark.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Measures memory use of the Trie on a dictionary file
+*/
+#include <iostream>
+#include <fstream>
+#include <cstdlib>
+#include <cstddef>
+#include <new>
+#include <unordered_map>
+#include <memory>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include <iterator>
+#include "trie.hpp"
+#include "radixtrie.hpp"
+#include "frozentrie.hpp"
+#include "loudstrie.hpp"
+#include "dawg.hpp"
+#include "bursttrie.hpp"
+#include "hattrie.hpp"
+#include "persistenttrie.hpp"
+#include "triemap.hpp"
+#include "suffixautomaton.hpp"
+#include "twowaytrie.hpp"
+
+using namespace std;
+
+///////////////////////////////////////////////////////////////
+///////////// Heap Accounting /////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+// every allocation is prefixed with its size so delete knows how much
+//  heap is given back
+static size_t liveBytes = 0;
+static size_t allocations = 0;
+static const size_t HEADER = alignof(std::max_align_t);
+
+void* operator new(size_t bytes)
+{
+	char* block = static_cast<char*>(malloc(bytes + HEADER));
+	if (block == nullptr) {
+		throw std::bad_alloc();
+	}
+	*reinterpret_cast<size_t*>(block) = bytes;
+	liveBytes += bytes;
+	++allocations;
+	return block + HEADER;
+}
+
+void operator delete(void* ptr) noexcept
+{
+	if (ptr != nullptr) {
+		char* block = static_cast<char*>(ptr) - HEADER;
+		liveBytes -= *reinterpret_cast<size_t*>(block);
+		free(block);
+	}
+}
+
+void operator delete(void* ptr, size_t) noexcept
+{
+	operator delete(ptr);
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Reference Trie //////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+/// Node layout the Trie used before its arenas. Kept here so there is
+///  something to compare against
+struct MapNode {
+	bool endOfString_ = false;
+	std::unordered_map<char, std::shared_ptr<MapNode> > children_;
+};
+
+void mapInsert(MapNode& root, const string& word)
+{
+	MapNode* node = &root;
+	for (char c : word) {
+		std::shared_ptr<MapNode>& child = node->children_[c];
+		if (!child) {
+			child = std::make_shared<MapNode>(MapNode());
+		}
+		node = child.get();
+	}
+	node->endOfString_ = true;
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Benchmarks //////////////////////////////////////
+///////////////////////////////////////////////////////////////
+
+/**
+* \brief			Reports heap bytes per key and node count of a trie type
+* \param  name	    Name printed next to the results
+*         words	    Keys to insert
+*/
+template <typename T>
+void measure(const char* name, const vector<string>& words)
+{
+	size_t before = liveBytes;
+	T trie = T();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+	cout << name << ": " << double(liveBytes - before) / words.size()
+		<< " bytes per key (" << trie.totalNodes() << " nodes, memoryUsage "
+		<< trie.memoryUsage() << ")" << endl;
+}
+
+/**
+* \brief			Reports heap bytes per key for every node layout
+* \param  words	    Keys to insert
+*/
+void bytesPerKey(const vector<string>& words)
+{
+	size_t before = liveBytes;
+	{
+		MapNode root;
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			mapInsert(root, *i);
+		}
+		cout << "unordered_map<char, shared_ptr<Node>>: "
+			<< double(liveBytes - before) / words.size() << " bytes per key" << endl;
+	}
+
+	measure<Trie>("Trie arenas", words);
+	{
+		// words that end the same way share their ending nodes
+		Trie merged = Trie();
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			merged.insert(*i);
+		}
+		size_t memory = merged.memoryUsage();
+		merged.deduplicate();
+		cout << "Trie deduplicated: memoryUsage " << merged.memoryUsage() << " ("
+			<< memory << " before)" << endl;
+	}
+	measure<BasicTrie<NibbleAlphabet> >("Nibble Trie", words);
+	measure<RadixTrie>("RadixTrie", words);
+	measure<BurstTrie>("BurstTrie", words);
+	measure<HatTrie>("HatTrie", words);
+
+	// only the last version is kept. the ones before it are freed
+	before = liveBytes;
+	PersistentTrie version = PersistentTrie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		version = version.insert(*i);
+	}
+	cout << "PersistentTrie: " << double(liveBytes - before) / words.size()
+		<< " bytes per key (" << version.totalNodes() << " nodes, memoryUsage "
+		<< version.memoryUsage() << ")" << endl;
+}
+
+/**
+* \brief			Times exists over every key
+* \param  name	    Name printed next to the results
+*         trie      Trie being searched
+*         words	    Keys to look up
+*/
+template <typename T>
+void timeExists(const char* name, const T& trie, const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	size_t found = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			found += trie.exists(*i);
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << name << ": " << elapsed.count() / (ROUNDS * words.size())
+		<< " ns per exists (" << found / ROUNDS << " found)" << endl;
+}
+
+/**
+* \brief			Times loading every key into an empty trie
+* \param  name	    Name printed next to the results
+*         words	    Keys to insert
+*/
+template <typename T>
+void timeInsert(const char* name, const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	size_t before = allocations;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		T trie = T();
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			trie.insert(*i);
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << name << ": " << (allocations - before) / ROUNDS << " allocations, "
+		<< elapsed.count() / (ROUNDS * words.size()) << " ns per insert" << endl;
+}
+
+/**
+* \brief			Compares exists on a Trie, on read-only copies of it and on
+*					 the bucketed tries
+* \param  words	    Keys to insert and look up
+*/
+void lookupSpeed(const vector<string>& words)
+{
+	Trie trie = Trie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+	FrozenTrie frozen = FrozenTrie(trie);
+	LoudsTrie louds = LoudsTrie(trie);
+	Dawg graph = Dawg(trie);
+	BurstTrie burst = BurstTrie();
+	HatTrie hat = HatTrie();
+	PersistentTrie version = PersistentTrie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		burst.insert(*i);
+		hat.insert(*i);
+		version = version.insert(*i);
+	}
+
+	timeExists("Trie", trie, words);
+	timeExists("FrozenTrie", frozen, words);
+	timeExists("LoudsTrie", louds, words);
+	timeExists("Dawg", graph, words);
+	timeExists("BurstTrie", burst, words);
+	timeExists("HatTrie", hat, words);
+	timeExists("PersistentTrie", version, words);
+	cout << "FrozenTrie memoryUsage " << frozen.memoryUsage() << endl;
+	cout << "LoudsTrie memoryUsage " << louds.memoryUsage() << " ("
+		<< 8.0 * louds.memoryUsage() / louds.totalNodes() << " bits per node)" << endl;
+	cout << "Dawg memoryUsage " << graph.memoryUsage() << " (" << graph.totalNodes()
+		<< " nodes)" << endl;
+}
+
+/**
+* \brief			Counts heap allocations and times bulk loading
+* \param  words	    Keys to insert
+*/
+void insertSpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+
+	size_t before = allocations;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		MapNode root;
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			mapInsert(root, *i);
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "unordered_map<char, shared_ptr<Node>>: " << (allocations - before) / ROUNDS
+		<< " allocations, " << elapsed.count() / (ROUNDS * words.size()) << " ns per insert" << endl;
+
+	timeInsert<Trie>("Trie", words);
+	timeInsert<BurstTrie>("BurstTrie", words);
+	timeInsert<HatTrie>("HatTrie", words);
+
+	// every insert copies the path to its word
+	before = allocations;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		PersistentTrie version = PersistentTrie();
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			version = version.insert(*i);
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "PersistentTrie: " << (allocations - before) / ROUNDS << " allocations, "
+		<< elapsed.count() / (ROUNDS * words.size()) << " ns per insert" << endl;
+
+	// churn reuses freed nodes so the arenas stop growing
+	Trie trie = Trie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+	size_t memory = trie.memoryUsage();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			trie.remove(*i);
+		}
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			trie.insert(*i);
+		}
+	}
+	cout << "Trie memoryUsage after " << ROUNDS << " rounds of remove and insert: "
+		<< trie.memoryUsage() << " (" << memory << " after first load)" << endl;
+
+	// a snapshot that then takes one change. copying moves every node,
+	//  a clone only the path to the word
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		Trie copy = trie;
+		copy.insert("snapshot");
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie copy + insert: " << elapsed.count() / ROUNDS << " ns" << endl;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		Trie copy = trie.clone();
+		copy.insert("snapshot");
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie clone + insert: " << elapsed.count() / ROUNDS << " ns" << endl;
+}
+
+/**
+* \brief			Compares TrieMap with a Trie next to an unordered_map
+* \param  words	    Keys, each mapped to its line number
+*/
+void mapSpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+
+	size_t before = liveBytes;
+	Trie trie = Trie();
+	unordered_map<string, uint32_t> values;
+	for (size_t i = 0; i != words.size(); ++i) {
+		trie.insert(words[i]);
+		values[words[i]] = static_cast<uint32_t>(i);
+	}
+	cout << "Trie + unordered_map<string, uint32_t>: " << double(liveBytes - before) / words.size()
+		<< " bytes per key" << endl;
+	before = liveBytes;
+	TrieMap<uint32_t> map = TrieMap<uint32_t>();
+	for (size_t i = 0; i != words.size(); ++i) {
+		map.insert(words[i], static_cast<uint32_t>(i));
+	}
+	cout << "TrieMap<uint32_t>: " << double(liveBytes - before) / words.size()
+		<< " bytes per key (memoryUsage " << map.memoryUsage() << ")" << endl;
+
+	// the pair walks the trie and hashes the key, the map only walks
+	size_t sum = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			if (trie.exists(*i)) {
+				sum += values.find(*i)->second;
+			}
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie + unordered_map: " << elapsed.count() / (ROUNDS * words.size()) << " ns per find" << endl;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			const uint32_t* value = map.find(*i);
+			sum += (value != nullptr) ? *value : 0;
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "TrieMap: " << elapsed.count() / (ROUNDS * words.size()) << " ns per find ("
+		<< sum << ")" << endl;
+}
+
+/**
+* \brief			Compares SuffixAutomaton::containing with a scan of every word
+* \param  words	    Keys to insert. Their middles are searched for
+*/
+void substringSpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	SuffixAutomaton automaton = SuffixAutomaton();
+	auto start = chrono::steady_clock::now();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		automaton.insert(*i);
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "SuffixAutomaton: " << automaton.totalStates() << " states, memoryUsage "
+		<< automaton.memoryUsage() << ", " << elapsed.count() / words.size() << " ns per insert" << endl;
+
+	// three chars from the middle of every 10th word
+	vector<string> fragments;
+	for (size_t i = 0; i < words.size(); i += 10) {
+		fragments.push_back(words[i].substr(words[i].size() / 3, 3));
+	}
+
+	size_t found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto f = fragments.begin(); f != fragments.end(); ++f) {
+			for (auto i = words.begin(); i != words.end(); ++i) {
+				found += (i->find(*f) != string::npos);
+			}
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "scan of every word: " << elapsed.count() / (ROUNDS * fragments.size())
+		<< " ns per search (" << found / ROUNDS << " found)" << endl;
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto f = fragments.begin(); f != fragments.end(); ++f) {
+			found += automaton.containing(*f).size();
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "SuffixAutomaton containing: " << elapsed.count() / (ROUNDS * fragments.size())
+		<< " ns per search (" << found / ROUNDS << " found)" << endl;
+}
+
+/**
+* \brief			Times finding the words that end with a suffix
+* \param  words	    Words put in the tries
+*/
+void suffixSpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	TwoWayTrie trie = TwoWayTrie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+	cout << "TwoWayTrie: memoryUsage " << trie.memoryUsage() << endl;
+
+	// last two chars of every 10th word, and its first two for restOfString
+	vector<string> suffixes;
+	vector<string> prefixes;
+	for (size_t i = 0; i < words.size(); i += 10) {
+		if (words[i].size() >= 2) {
+			suffixes.push_back(words[i].substr(words[i].size() - 2));
+			prefixes.push_back(words[i].substr(0, 2));
+		}
+	}
+
+	size_t found = 0;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto s = suffixes.begin(); s != suffixes.end(); ++s) {
+			for (auto i = words.begin(); i != words.end(); ++i) {
+				found += (i->size() > s->size() && i->compare(i->size() - s->size(), s->size(), *s) == 0);
+			}
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "scan of every word: " << elapsed.count() / (ROUNDS * suffixes.size())
+		<< " ns per search (" << found / ROUNDS << " found)" << endl;
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto s = suffixes.begin(); s != suffixes.end(); ++s) {
+			found += trie.endingWith(*s).size();
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "TwoWayTrie endingWith: " << elapsed.count() / (ROUNDS * suffixes.size())
+		<< " ns per search (" << found / ROUNDS << " found)" << endl;
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			found += trie.restOfString(*p).size();
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "TwoWayTrie restOfString: " << elapsed.count() / (ROUNDS * prefixes.size())
+		<< " ns per search (" << found / ROUNDS << " found)" << endl;
+}
+
+/**
+* \brief			Times the ways to get the completions of a prefix
+* \param  words	    Words put in the trie
+*/
+void completionSpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	Trie trie = Trie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+
+	// first char of every 100th word, so a lot of words per prefix
+	vector<string> prefixes;
+	for (size_t i = 0; i < words.size(); i += 100) {
+		prefixes.push_back(words[i].substr(0, 1));
+	}
+
+	size_t found = 0;
+	size_t before = allocations;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			found += trie.restOfString(*p).size();
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "restOfString: " << (allocations - before) / (ROUNDS * prefixes.size()) << " allocations, "
+		<< elapsed.count() / (ROUNDS * prefixes.size()) << " ns per prefix (" << found / ROUNDS << " found)" << endl;
+
+	// one vector for every call. it keeps its room
+	vector<string> output;
+	found = 0;
+	before = allocations;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			output.clear();
+			trie.restOfString(*p, back_inserter(output));
+			found += output.size();
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "restOfString into one vector: " << (allocations - before) / (ROUNDS * prefixes.size()) << " allocations, "
+		<< elapsed.count() / (ROUNDS * prefixes.size()) << " ns per prefix (" << found / ROUNDS << " found)" << endl;
+
+	// nothing kept at all
+	found = 0;
+	before = allocations;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			trie.forEachCompletion(*p, [&](const string&) {
+				++found;
+			});
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "forEachCompletion: " << (allocations - before) / (ROUNDS * prefixes.size()) << " allocations, "
+		<< elapsed.count() / (ROUNDS * prefixes.size()) << " ns per prefix (" << found / ROUNDS << " found)" << endl;
+
+	// autocomplete only shows the first few
+	const size_t SHOWN = 5;
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			vector<string> all = trie.restOfString(*p);
+			found += min(all.size(), SHOWN);
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "first " << SHOWN << " of restOfString: " << elapsed.count() / (ROUNDS * prefixes.size())
+		<< " ns per prefix (" << found / ROUNDS << " found)" << endl;
+	found = 0;
+	before = allocations;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto p = prefixes.begin(); p != prefixes.end(); ++p) {
+			size_t shown = 0;
+			for (auto i = trie.completions(*p).begin(); shown != SHOWN && i != Trie::CompletionSentinel(); ++i) {
+				++shown;
+			}
+			found += shown;
+		}
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "first " << SHOWN << " of completions: " << (allocations - before) / (ROUNDS * prefixes.size()) << " allocations, "
+		<< elapsed.count() / (ROUNDS * prefixes.size()) << " ns per prefix (" << found / ROUNDS << " found)" << endl;
+}
+
+/**
+* \brief			Times insert, exists and remove on keys over 200 bytes
+* \param  words	    Words joined into long keys
+*/
+void longKeySpeed(const vector<string>& words)
+{
+	const size_t ROUNDS = 20;
+	const size_t KEYS = 2000;
+
+	// paths of words, like long URLs. each key is at least 200 bytes
+	vector<string> keys;
+	for (size_t i = 0; i != KEYS; ++i) {
+		string key = "https://example.com";
+		for (size_t j = i; key.size() < 200; j = (j * 31 + 7) % words.size()) {
+			key += '/';
+			key += words[j];
+		}
+		keys.push_back(key);
+	}
+
+	timeInsert<Trie>("Trie long keys", keys);
+	Trie trie = Trie();
+	for (auto i = keys.begin(); i != keys.end(); ++i) {
+		trie.insert(*i);
+	}
+
+	size_t found = 0;
+	size_t before = allocations;
+	auto start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		for (auto i = keys.begin(); i != keys.end(); ++i) {
+			found += trie.exists(*i);
+		}
+	}
+	chrono::duration<double, nano> elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie long keys: " << (allocations - before) / ROUNDS << " allocations, "
+		<< elapsed.count() / (ROUNDS * keys.size()) << " ns per exists (" << found / ROUNDS << " found)" << endl;
+
+	// every key is below the common start, so this walks the whole trie
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		found += trie.restOfString("https://example.com/").size();
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie long keys: " << elapsed.count() / ROUNDS << " ns per restOfString ("
+		<< found / ROUNDS << " found)" << endl;
+	found = 0;
+	start = chrono::steady_clock::now();
+	for (size_t round = 0; round != ROUNDS; ++round) {
+		found += trie.totalNodes();
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie long keys: " << elapsed.count() / ROUNDS << " ns per totalNodes ("
+		<< found / ROUNDS << " nodes)" << endl;
+
+	found = 0;
+	before = allocations;
+	start = chrono::steady_clock::now();
+	for (auto i = keys.begin(); i != keys.end(); ++i) {
+		found += trie.remove(*i);
+	}
+	elapsed = chrono::steady_clock::now() - start;
+	cout << "Trie long keys: " << (allocations - before) << " allocations, "
+		<< elapsed.count() / keys.size() << " ns per remove (" << found << " removed)" << endl;
+}
+
+/**
+* \brief			Times random exists on a big trie before and after relayout
+* \param  words	    Keys that are joined in pairs into a bigger key set
+*/
+void layoutSpeed(const vector<string>& words)
+{
+	// 100 keys per word, shuffled so nodes land all over the arena. big
+	//  enough that the trie does not fit in the last level cache
+	vector<string> keys;
+	for (size_t i = 0; i != words.size(); ++i) {
+		for (size_t j = 0; j != 100; ++j) {
+			keys.push_back(words[i] + words[(i * 7919 + j * 104729) % words.size()]);
+		}
+	}
+	mt19937 random(12345);
+	shuffle(keys.begin(), keys.end(), random);
+	Trie trie = Trie();
+	for (auto i = keys.begin(); i != keys.end(); ++i) {
+		trie.insert(*i);
+	}
+
+	// look some of them up in another random order
+	shuffle(keys.begin(), keys.end(), random);
+	vector<string> probes(keys.begin(), keys.begin() + keys.size() / 5);
+	cout << keys.size() << " joined keys, " << trie.totalNodes() << " nodes, memoryUsage "
+		<< trie.memoryUsage() << endl;
+	timeExists("Trie insertion order", trie, probes);
+	trie.relayout();
+	timeExists("Trie van Emde Boas order", trie, probes);
+}
+
+int main(int argc, const char** argv)
+{
+	const char* fname = (argc == 2) ? argv[1] : "google-10000-english.txt";
+	ifstream dictFile(fname);
+	if (!dictFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+
+	// read the whole dictionary before measuring anything
+	vector<string> words;
+	string line;
+	while (getline(dictFile, line)) {
+		if (!line.empty()) {
+			words.push_back(line);
+		}
+	}
+	cout << words.size() << " keys from " << fname << endl;
+
+	bytesPerKey(words);
+	insertSpeed(words);
+	lookupSpeed(words);
+	mapSpeed(words);
+	substringSpeed(words);
+	suffixSpeed(words);
+	completionSpeed(words);
+	longKeySpeed(words);
+	layoutSpeed(words);
+	return 0;
+}
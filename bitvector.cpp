@@ -0,0 +1,156 @@
+/**
+* \file bitvector.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for bitvector.hpp
+*/
+#include "bitvector.hpp"
+
+///////////////////////////////////////////////////////////////
+///////////// BitVector Implementation ////////////////////////
+///////////////////////////////////////////////////////////////
+
+const size_t BitVector::BLOCKWORDS;
+const size_t BitVector::SELECTSAMPLE;
+
+BitVector::BitVector()
+	: words_{ std::vector<uint64_t>() }, ranks_{ std::vector<uint64_t>() },
+	zeroBlocks_{ std::vector<uint64_t>() }, size_{ 0 }
+{
+	// nothing to do here
+}
+
+void BitVector::push_back(bool bit)
+{
+	if (size_ % 64 == 0) {
+		words_.push_back(0);
+	}
+	if (bit) {
+		words_.back() |= uint64_t(1) << (size_ % 64);
+	}
+	++size_;
+}
+
+void BitVector::build()
+{
+	// one entry per block plus one past the end so select can search
+	//  between two entries
+	ranks_.assign(words_.size() / BLOCKWORDS + 2, 0);
+	uint64_t count = 0;
+	for (size_t i = 0; i != words_.size(); ++i) {
+		if (i % BLOCKWORDS == 0) {
+			ranks_[i / BLOCKWORDS] = count;
+		}
+		count += popcount64(words_[i]);
+	}
+	for (size_t block = (words_.size() + BLOCKWORDS - 1) / BLOCKWORDS; block != ranks_.size(); ++block) {
+		ranks_[block] = count;
+	}
+
+	// sample the block of every SELECTSAMPLE-th clear bit. the last entry
+	//  is the final block so a search always has an upper end
+	zeroBlocks_.clear();
+	for (size_t block = 0; block + 1 != ranks_.size(); ++block) {
+		size_t zerosAfter = (block + 1) * BLOCKWORDS * 64 - static_cast<size_t>(ranks_[block + 1]);
+		while (zeroBlocks_.size() * SELECTSAMPLE < zerosAfter) {
+			zeroBlocks_.push_back(block);
+		}
+	}
+	zeroBlocks_.push_back(ranks_.size() - 1);
+	words_.shrink_to_fit();
+}
+
+bool BitVector::operator[](size_t pos) const
+{
+	return (words_[pos / 64] >> (pos % 64)) & 1;
+}
+
+size_t BitVector::rank1(size_t pos) const
+{
+	// directory entry plus the words of the block before pos
+	size_t word = pos / 64;
+	size_t count = static_cast<size_t>(ranks_[word / BLOCKWORDS]);
+	for (size_t i = word - word % BLOCKWORDS; i != word; ++i) {
+		count += popcount64(words_[i]);
+	}
+	if (pos % 64 != 0) {
+		count += popcount64(words_[word] & ((uint64_t(1) << (pos % 64)) - 1));
+	}
+	return count;
+}
+
+size_t BitVector::select0(size_t k) const
+{
+	// find the last block with fewer than k clear bits before it. the
+	//  samples around k bound the search
+	size_t sample = (k - 1) / SELECTSAMPLE;
+	size_t low = static_cast<size_t>(zeroBlocks_[sample]);
+	size_t high = static_cast<size_t>(zeroBlocks_[sample + 1]) + 1;
+	while (high - low > 1) {
+		size_t middle = (low + high) / 2;
+		size_t zeros = middle * BLOCKWORDS * 64 - static_cast<size_t>(ranks_[middle]);
+		if (zeros < k) {
+			low = middle;
+		}
+		else {
+			high = middle;
+		}
+	}
+
+	// walk the words of that block
+	k -= low * BLOCKWORDS * 64 - static_cast<size_t>(ranks_[low]);
+	size_t word = low * BLOCKWORDS;
+	while (true) {
+		uint64_t zeros = ~words_[word];
+		unsigned count = popcount64(zeros);
+		if (k <= count) {
+			// skip whole bytes, then clear the k - 1 lowest clear bits
+			//  of the byte that has it and take the next one
+			unsigned shift = 0;
+			unsigned inByte = popcount64(zeros & 0xff);
+			while (k > inByte) {
+				k -= inByte;
+				shift += 8;
+				inByte = popcount64((zeros >> shift) & 0xff);
+			}
+			zeros >>= shift;
+			for (size_t i = 1; i != k; ++i) {
+				zeros &= zeros - 1;
+			}
+			return word * 64 + shift + lowestBit64(zeros);
+		}
+		k -= count;
+		++word;
+	}
+}
+
+size_t BitVector::nextZero(size_t pos) const
+{
+	if (pos >= size_) {
+		return size_;
+	}
+
+	// look at a whole word at a time
+	size_t word = pos / 64;
+	uint64_t zeros = ~words_[word] & (~uint64_t(0) << (pos % 64));
+	while (zeros == 0 && ++word != words_.size()) {
+		zeros = ~words_[word];
+	}
+	if (zeros == 0) {
+		return size_;
+	}
+	size_t found = word * 64 + lowestBit64(zeros);
+	return (found < size_) ? found : size_;
+}
+
+size_t BitVector::size() const
+{
+	return size_;
+}
+
+size_t BitVector::memoryUsage() const
+{
+	return sizeof(BitVector) + words_.capacity() * sizeof(uint64_t)
+		+ ranks_.capacity() * sizeof(uint64_t) + zeroBlocks_.capacity() * sizeof(uint64_t);
+}
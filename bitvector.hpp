@@ -0,0 +1,127 @@
+/**
+* \file bitvector.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for BitVector, a bit array with rank and select
+*
+*/
+
+// include gaurds
+#ifndef BITVECTOR_HPP_INCLUDED
+#define BITVECTOR_HPP_INCLUDED 1
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+* \brief			Amount of set bits in a word
+* \param  word		Bits being counted
+* \return			Amount of set bits
+*/
+inline unsigned popcount64(uint64_t word)
+{
+#ifdef _MSC_VER
+	return static_cast<unsigned>(__popcnt64(word));
+#else
+	return static_cast<unsigned>(__builtin_popcountll(word));
+#endif
+}
+
+/**
+* \brief			Position of the lowest set bit of a word
+* \param  word		Bits being searched. Must not be 0
+* \return			Position of the lowest set bit
+*/
+inline unsigned lowestBit64(uint64_t word)
+{
+#ifdef _MSC_VER
+	unsigned long index;
+	_BitScanForward64(&index, word);
+	return static_cast<unsigned>(index);
+#else
+	return static_cast<unsigned>(__builtin_ctzll(word));
+#endif
+}
+
+/// Append-only array of bits. After build() it answers rank (set bits
+///  before a position) in O(1) and select (position of the k-th clear
+///  bit) with a search between two sampled blocks
+class BitVector {
+public:
+	/**
+	* \brief Default Constructor to create an empty bit vector
+	*/
+	BitVector();
+
+	/**
+	* \brief			Adds a bit at the end
+	* \param  bit	    Bit being added
+	* \note				build() has to be called again before rank or select
+	*/
+	void push_back(bool bit);
+
+	/**
+	* \brief			Builds the rank directory
+	*/
+	void build();
+
+	/**
+	* \brief			Reads a bit
+	* \param  pos	    Position of the bit. Must be less than size()
+	* \return			The bit
+	*/
+	bool operator[](size_t pos) const;
+
+	/**
+	* \brief			Counts the set bits before a position
+	* \param  pos	    End of the counted range. Must be at most size()
+	* \return			Amount of set bits in [0, pos)
+	*/
+	size_t rank1(size_t pos) const;
+
+	/**
+	* \brief			Finds the k-th clear bit
+	* \param  k		    Which clear bit. Starts at 1 and must be at most
+	*					 the amount of clear bits
+	* \return			Position of the k-th clear bit
+	*/
+	size_t select0(size_t k) const;
+
+	/**
+	* \brief			Finds the first clear bit at or after a position
+	* \param  pos	    Where the search starts
+	* \return			Position of the clear bit. size() if there is none
+	*/
+	size_t nextZero(size_t pos) const;
+
+	/**
+	* \brief			Amount of bits
+	* \return			Amount of bits
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Bytes used by the bits and the rank directory
+	* \return			Bytes used
+	*/
+	size_t memoryUsage() const;
+private:
+	/// 64 bit words covered by each entry of the rank directory
+	static const size_t BLOCKWORDS = 8;
+
+	/// Clear bits between two entries of the select samples
+	static const size_t SELECTSAMPLE = 512;
+
+	/// private data members
+	std::vector<uint64_t> words_; // bits, lowest bit of words_[0] first
+	std::vector<uint64_t> ranks_; // set bits before each block of BLOCKWORDS words
+	std::vector<uint64_t> zeroBlocks_; // block holding clear bit 1, SELECTSAMPLE + 1, ...
+	size_t size_; // amount of bits
+};
+
+#endif
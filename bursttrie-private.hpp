@@ -0,0 +1,421 @@
+/**
+* \file bursttrie-private.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for bursttrie.hpp. Included at the end of bursttrie.hpp
+*/
+#include <algorithm> // min
+#include <stdexcept> // length_error
+
+///////////////////////////////////////////////////////////////
+///////////// BasicBurstTrie Implementation ///////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename Buckets>
+const typename BasicBurstTrie<Buckets>::NodeIndex BasicBurstTrie<Buckets>::ROOT;
+
+template <typename Buckets>
+BasicBurstTrie<Buckets>::BasicBurstTrie(size_t burstLimit)
+	: nodes_(1, Node()), edges_{ std::vector<Edge>() }, freeBlocks_{ EdgeBlock::FreeLists() },
+	buckets_{ std::vector<Bucket>() },
+	freeBuckets_{ std::vector<uint32_t>() }, freeNodes_{ ROOT },
+	burstLimit_{ std::min<size_t>(burstLimit, UINT16_MAX - 1) }, size_{ 0 }, wordsRemoved_{ 0 }
+{
+	// nothing to do here
+}
+
+template <typename Buckets>
+void BasicBurstTrie<Buckets>::insert(std::string word)
+{
+	if (word.size() == 0) {
+		// empty word is never stored
+		return;
+	}
+
+	// walk the trie nodes. a missing char gets an empty bucket
+	NodeIndex subNode = ROOT;
+	size_t pos = 0;
+	while (!nodes_[subNode].isBucket_ && pos != word.size()) {
+		NodeIndex found = findChild(subNode, word[pos]);
+		if (found == ROOT) {
+			found = addChild(subNode, word[pos]);
+		}
+		subNode = found;
+		++pos;
+	}
+
+	if (pos == word.size()) {
+		// word ends at the node itself
+		if (!nodes_[subNode].endOfString_) {
+			nodes_[subNode].endOfString_ = true;
+			++size_;
+		}
+		return;
+	}
+
+	// rest of the word goes in the bucket
+	Node& node = nodes_[subNode];
+	if (!Buckets::add(buckets_[node.children_], node.childCount_, word.data() + pos, word.size() - pos)) {
+		// already there
+		return;
+	}
+	++node.childCount_;
+	++size_;
+
+	if (node.childCount_ > burstLimit_) {
+		burst(subNode);
+	}
+}
+
+template <typename Buckets>
+bool BasicBurstTrie<Buckets>::exists(std::string word) const
+{
+	size_t pos;
+	NodeIndex found = descend(word, pos);
+	if (found == ROOT) {
+		// character not in trie or empty word
+		return false;
+	}
+	if (pos == word.size()) {
+		return nodes_[found].endOfString_;
+	}
+
+	// rest of the word has to be in the bucket
+	return Buckets::contains(buckets_[nodes_[found].children_], word.data() + pos, word.size() - pos);
+}
+
+template <typename Buckets>
+std::vector<std::string> BasicBurstTrie<Buckets>::restOfString(std::string prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	size_t pos;
+	NodeIndex found = descend(prefix, pos);
+	if (found == ROOT && pos != prefix.size()) {
+		// character not in trie... no suggestions
+		return output;
+	}
+	if (pos == prefix.size()) {
+		// prefix ends at a node. keep searching sub nodes for words
+		collectWords(found, prefix, output);
+		return output;
+	}
+
+	// prefix ends inside a bucket. suggest the longer suffixes that
+	//  start with the rest of the prefix
+	std::vector<std::string> suffixes;
+	Buckets::collect(buckets_[nodes_[found].children_], prefix.data() + pos, prefix.size() - pos, suffixes);
+	for (auto i = suffixes.begin(); i != suffixes.end(); ++i) {
+		output.push_back(prefix.substr(0, pos) + *i);
+	}
+	return output;
+}
+
+template <typename Buckets>
+bool BasicBurstTrie<Buckets>::remove(std::string word)
+{
+	size_t pos;
+	NodeIndex found = descend(word, pos);
+	if (found == ROOT) {
+		// character not in trie or empty word
+		return false;
+	}
+
+	if (pos == word.size()) {
+		if (!nodes_[found].endOfString_) {
+			// didnt unmark end of word... return false
+			return false;
+		}
+		nodes_[found].endOfString_ = false;
+	}
+	else {
+		// take the suffix out of the bucket
+		if (!Buckets::erase(buckets_[nodes_[found].children_], word.data() + pos, word.size() - pos)) {
+			return false;
+		}
+		--nodes_[found].childCount_;
+	}
+	--size_;
+	++wordsRemoved_;
+
+	// check if we need to remove unused nodes
+	if (wordsRemoved_ == MAXWORDSREMOVED) {
+		removeUnusedNodes(ROOT);
+		wordsRemoved_ = 0;
+	}
+	return true;
+}
+
+template <typename Buckets>
+void BasicBurstTrie<Buckets>::removeAll()
+{
+	nodes_ = std::vector<Node>(1, Node());
+	edges_ = std::vector<Edge>();
+	freeBlocks_ = EdgeBlock::FreeLists();
+	buckets_ = std::vector<Bucket>();
+	freeBuckets_ = std::vector<uint32_t>();
+	freeNodes_ = ROOT;
+	size_ = 0;
+	wordsRemoved_ = 0;
+}
+
+template <typename Buckets>
+size_t BasicBurstTrie<Buckets>::size() const
+{
+	return size_;
+}
+
+template <typename Buckets>
+bool BasicBurstTrie<Buckets>::empty() const
+{
+	return size_ == 0;
+}
+
+template <typename Buckets>
+size_t BasicBurstTrie<Buckets>::totalNodes() const
+{
+	return countAllNodes(ROOT);
+}
+
+template <typename Buckets>
+std::ostream& BasicBurstTrie<Buckets>::showStatistics(std::ostream& out) const
+{
+	out << "Words contained: " << size_;
+	out << ", Total nodes: " << totalNodes();
+	out << ", Words left till removing unused nodes: " << (MAXWORDSREMOVED - wordsRemoved_);
+	out << std::endl;
+	return out;
+}
+
+template <typename Buckets>
+std::ostream& BasicBurstTrie<Buckets>::print(std::ostream& out) const
+{
+	// find all the words inside the trie
+	std::vector<std::string> output = std::vector<std::string>();
+	collectWords(ROOT, "", output);
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+template <typename Buckets>
+size_t BasicBurstTrie<Buckets>::memoryUsage() const
+{
+	size_t bytes = sizeof(BasicBurstTrie) + nodes_.capacity() * sizeof(Node)
+		+ edges_.capacity() * sizeof(Edge) + buckets_.capacity() * sizeof(Bucket)
+		+ freeBuckets_.capacity() * sizeof(uint32_t);
+	for (auto i = buckets_.begin(); i != buckets_.end(); ++i) {
+		bytes += Buckets::bytes(*i);
+	}
+	return bytes;
+}
+
+template <typename Buckets>
+typename BasicBurstTrie<Buckets>::NodeIndex BasicBurstTrie<Buckets>::findChild(NodeIndex subNode, char c) const
+{
+	const Node& node = nodes_[subNode];
+	size_t found = EdgeBlock::find(edges_, node.children_, node.childCount_, c);
+	return (found != edges_.size()) ? edges_[found].node_ : ROOT;
+}
+
+template <typename Buckets>
+typename BasicBurstTrie<Buckets>::NodeIndex BasicBurstTrie<Buckets>::addChild(NodeIndex subNode, char c)
+{
+	// new child starts as an empty bucket
+	NodeIndex child = newNode();
+	nodes_[child].isBucket_ = true;
+	if (freeBuckets_.empty()) {
+		nodes_[child].children_ = static_cast<uint32_t>(buckets_.size());
+		buckets_.push_back(Bucket());
+	}
+	else {
+		nodes_[child].children_ = freeBuckets_.back();
+		freeBuckets_.pop_back();
+	}
+
+	Node& node = nodes_[subNode];
+	EdgeBlock::insert(edges_, freeBlocks_, node.children_, node.childCount_, node.childCapacity_, Edge{ c, child });
+	return child;
+}
+
+template <typename Buckets>
+typename BasicBurstTrie<Buckets>::NodeIndex BasicBurstTrie<Buckets>::newNode()
+{
+	if (freeNodes_ == ROOT) {
+		// no free nodes. grow the arena while indices stay below UINT32_MAX
+		if (nodes_.size() >= UINT32_MAX) {
+			throw std::length_error("Burst trie has more nodes than a NodeIndex can address");
+		}
+		nodes_.push_back(Node());
+		return static_cast<NodeIndex>(nodes_.size() - 1);
+	}
+
+	// take the first free node
+	NodeIndex slot = freeNodes_;
+	freeNodes_ = nodes_[slot].children_;
+	nodes_[slot] = Node();
+	return slot;
+}
+
+template <typename Buckets>
+void BasicBurstTrie<Buckets>::freeNode(NodeIndex subNode)
+{
+	Node& node = nodes_[subNode];
+	if (node.isBucket_) {
+		// give the empty bucket back along with its memory
+		Bucket().swap(buckets_[node.children_]);
+		freeBuckets_.push_back(node.children_);
+	}
+	else {
+		EdgeBlock::release(freeBlocks_, node.children_, node.childCapacity_);
+	}
+	node = Node();
+	node.children_ = freeNodes_;
+	freeNodes_ = subNode;
+}
+
+template <typename Buckets>
+typename BasicBurstTrie<Buckets>::NodeIndex BasicBurstTrie<Buckets>::descend(const std::string& word, size_t& pos) const
+{
+	NodeIndex subNode = ROOT;
+	pos = 0;
+	while (!nodes_[subNode].isBucket_ && pos != word.size()) {
+		subNode = findChild(subNode, word[pos]);
+		if (subNode == ROOT) {
+			// character not in trie
+			return ROOT;
+		}
+		++pos;
+	}
+	return subNode;
+}
+
+template <typename Buckets>
+void BasicBurstTrie<Buckets>::burst(NodeIndex subNode)
+{
+	// take the suffixes away from the node, sorted
+	uint32_t bucketIndex = nodes_[subNode].children_;
+	std::vector<std::string> suffixes;
+	suffixes.reserve(nodes_[subNode].childCount_);
+	Buckets::collect(buckets_[bucketIndex], "", 0, suffixes);
+	Bucket().swap(buckets_[bucketIndex]);
+	freeBuckets_.push_back(bucketIndex);
+	nodes_[subNode].isBucket_ = false;
+	nodes_[subNode].childCount_ = 0;
+	nodes_[subNode].childCapacity_ = 0;
+	nodes_[subNode].children_ = 0;
+
+	// each first char is one run. the rest of each suffix goes to its
+	//  new bucket, still in order
+	NodeIndex child = ROOT;
+	for (auto i = suffixes.begin(); i != suffixes.end(); ++i) {
+		if (child == ROOT || (*i)[0] != (*(i - 1))[0]) {
+			child = addChild(subNode, (*i)[0]);
+		}
+		if (i->size() == 1) {
+			nodes_[child].endOfString_ = true;
+		}
+		else {
+			Node& node = nodes_[child];
+			Buckets::append(buckets_[node.children_], node.childCount_, i->data() + 1, i->size() - 1);
+			++node.childCount_;
+		}
+	}
+
+	// a run can be too big on its own
+	for (size_t i = 0; i != nodes_[subNode].childCount_; ++i) {
+		NodeIndex next = edges_[nodes_[subNode].children_ + i].node_;
+		if (nodes_[next].childCount_ > burstLimit_) {
+			burst(next);
+		}
+	}
+}
+
+template <typename Buckets>
+void BasicBurstTrie<Buckets>::collectWords(NodeIndex subNode, const std::string& currWord,
+	std::vector<std::string>& output) const
+{
+	const Node& node = nodes_[subNode];
+	if (node.isBucket_) {
+		// suffixes come out sorted so words come out in order
+		std::vector<std::string> suffixes;
+		suffixes.reserve(node.childCount_);
+		Buckets::collect(buckets_[node.children_], "", 0, suffixes);
+		for (auto i = suffixes.begin(); i != suffixes.end(); ++i) {
+			output.push_back(currWord + *i);
+		}
+		return;
+	}
+
+	for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+		const Edge& edge = edges_[i];
+		std::string word = currWord + edge.key_;
+		if (nodes_[edge.node_].endOfString_) {
+			// add word to output
+			output.push_back(word);
+		}
+		collectWords(edge.node_, word, output);
+	}
+}
+
+template <typename Buckets>
+bool BasicBurstTrie<Buckets>::removeUnusedNodes(NodeIndex subNode)
+{
+	const Node& node = nodes_[subNode];
+	if (node.isBucket_) {
+		// bucket is used while it holds a suffix
+		return node.childCount_ != 0;
+	}
+
+	size_t first = node.children_;
+	size_t last = first + node.childCount_;
+	size_t kept = first;
+	for (size_t i = first; i != last; ++i) {
+		// search to see if we need to remove child
+		NodeIndex child = edges_[i].node_;
+		bool keepSubNode = removeUnusedNodes(child);
+		if (nodes_[child].endOfString_ || keepSubNode) {
+			edges_[kept] = edges_[i];
+			++kept;
+		}
+		else {
+			// no word ends at or below child. reuse it later
+			freeNode(child);
+		}
+	}
+	nodes_[subNode].childCount_ = static_cast<uint16_t>(kept - first);
+
+	// return whether we should keep nodes or not
+	return kept != first;
+}
+
+template <typename Buckets>
+size_t BasicBurstTrie<Buckets>::countAllNodes(NodeIndex subNode) const
+{
+	const Node& node = nodes_[subNode];
+	if (node.isBucket_) {
+		// buckets have no child nodes
+		return 0;
+	}
+
+	size_t count = 0;
+	for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+		// child is a node plus all of its own nodes
+		count += 1 + countAllNodes(edges_[i].node_);
+	}
+	return count;
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Node Implementation /////////////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename Buckets>
+BasicBurstTrie<Buckets>::Node::Node()
+	: endOfString_{ false }, isBucket_{ false }, childCount_{ 0 }, childCapacity_{ 0 }, children_{ 0 }
+{
+	// nothing to do here
+}
@@ -0,0 +1,103 @@
+/**
+* \file bursttrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for the sorted buckets of bursttrie.hpp. Compiles
+*		 BurstTrie once for every file that includes bursttrie.hpp
+*/
+#include "bursttrie.hpp"
+#include <algorithm> // min
+
+namespace {
+	/**
+	* \brief			Looks for a suffix in a bucket
+	* \param  bucket	Bucket being searched. Entries are sorted
+	*         chars     First char of the suffix
+	*         length    Length of the suffix
+	*         entry     Set to where the entry is, or where it would go
+	* \return			true if the suffix is in the bucket
+	*/
+	bool findEntry(const std::string& bucket, const char* chars, size_t length, size_t& entry)
+	{
+		size_t pos = 0;
+		while (pos != bucket.size()) {
+			entry = pos;
+			size_t current = SuffixEntry::readLength(bucket, pos);
+			int order = bucket.compare(pos, current, chars, length);
+			if (order >= 0) {
+				// found it or went past where it would be
+				return order == 0;
+			}
+			pos += current;
+		}
+		entry = bucket.size();
+		return false;
+	}
+}
+
+///////////////////////////////////////////////////////////////
+///////////// SortedBuckets Implementation ////////////////////
+///////////////////////////////////////////////////////////////
+
+const size_t SortedBuckets::LIMIT;
+
+bool SortedBuckets::add(Bucket& bucket, size_t, const char* chars, size_t length)
+{
+	// suffix goes in its place so the bucket stays sorted
+	size_t entry;
+	if (findEntry(bucket, chars, length, entry)) {
+		return false;
+	}
+	SuffixEntry::write(bucket, entry, chars, length);
+	return true;
+}
+
+void SortedBuckets::append(Bucket& bucket, size_t, const char* chars, size_t length)
+{
+	SuffixEntry::write(bucket, bucket.size(), chars, length);
+}
+
+bool SortedBuckets::contains(const Bucket& bucket, const char* chars, size_t length)
+{
+	size_t entry;
+	return findEntry(bucket, chars, length, entry);
+}
+
+bool SortedBuckets::erase(Bucket& bucket, const char* chars, size_t length)
+{
+	size_t entry;
+	if (!findEntry(bucket, chars, length, entry)) {
+		return false;
+	}
+	size_t end = entry;
+	end += SuffixEntry::readLength(bucket, end);
+	bucket.erase(entry, end - entry);
+	return true;
+}
+
+void SortedBuckets::collect(const Bucket& bucket, const char* rest, size_t length,
+	std::vector<std::string>& output)
+{
+	// suffixes that start with rest are next to each other
+	size_t entry = 0;
+	while (entry != bucket.size()) {
+		size_t current = SuffixEntry::readLength(bucket, entry);
+		int order = bucket.compare(entry, std::min(current, length), rest, length);
+		if (order == 0 && current > length) {
+			output.push_back(bucket.substr(entry, current));
+		}
+		else if (order > 0) {
+			// past every suffix that starts with rest
+			break;
+		}
+		entry += current;
+	}
+}
+
+size_t SortedBuckets::bytes(const Bucket& bucket)
+{
+	return bucket.capacity();
+}
+
+template class BasicBurstTrie<SortedBuckets>;
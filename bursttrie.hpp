@@ -0,0 +1,271 @@
+/**
+* \file bursttrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for BurstTrie, a trie with buckets at its leaves
+*
+*/
+
+// include gaurds
+#ifndef BURSTTRIE_HPP_INCLUDED
+#define BURSTTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include "trie.hpp" // MAXWORDSREMOVED
+#include "edgeblock.hpp"
+
+/// Default amount of suffixes a bucket holds before it bursts
+const size_t BURSTLIMIT = 32;
+
+/// A bucket policy decides how the suffixes of one bucket are kept. It
+///  provides:
+///   Bucket                                 type of a bucket. Default
+///                                           constructed empty
+///   LIMIT                                  default burst limit
+///   add(bucket, count, chars, length)      adds a suffix. false if it
+///                                           was there. count is the
+///                                           amount of suffixes before
+///   append(bucket, count, chars, length)   adds a suffix that is not
+///                                           there and comes after every
+///                                           suffix appended so far
+///   contains(bucket, chars, length)        true if the suffix is there
+///   erase(bucket, chars, length)           takes a suffix out. false if
+///                                           it was not there
+///   collect(bucket, rest, length, output)  adds to output, sorted, every
+///                                           suffix longer than rest that
+///                                           starts with it
+///   bytes(bucket)                          heap bytes the bucket uses
+
+/// Trie whose sparse subtrees are kept as buckets of the rest of each
+///  word. A bucket that grows past the burst limit is turned into a trie
+///  node with one bucket per first char. Same operations as Trie
+template <typename Buckets>
+class BasicBurstTrie {
+private:
+	struct Node;
+	struct Edge;
+	typedef uint32_t NodeIndex; // position of a node inside nodes_
+	typedef typename Buckets::Bucket Bucket;
+public:
+	/**
+	* \brief			Constructor to create an empty trie
+	* \param  burstLimit Amount of suffixes a bucket holds before it bursts
+	*/
+	explicit BasicBurstTrie(size_t burstLimit = Buckets::LIMIT);
+
+	/**
+	* \brief			Insert a string into the trie
+	* \param  word	    Inserted word
+	* \throws			std::length_error if the nodes or edges no longer
+	*					 fit in 32-bit offsets
+	*/
+	void insert(std::string word);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(std::string word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	* \note				Words come out in the same order as Trie::restOfString
+	*/
+	std::vector<std::string> restOfString(std::string prefix) const;
+
+	/**
+	* \brief			Remove a string from the trie
+	* \param  word      Word being removed
+	* \return			true if word is removed from trie. false otherwise
+	*/
+	bool remove(std::string word);
+
+	/**
+	* \brief			Remove all strings from trie
+	*/
+	void removeAll();
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if Trie is empty
+	* \return			true if Trie is empty. false otherwise
+	* \note				Trie can be empty but still have nodes.
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total mount of nodes in trie, buckets included
+	* \note             Root Node does not count as node.
+	*					Expensive call because it searches all nodes
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out Statistics of the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with statistics
+	* \note				Contains endl at end
+	*/
+	std::ostream& showStatistics(std::ostream& out) const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with words in Trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the trie object plus its arenas and buckets
+	* \note				Counts reserved capacity, not only what is in use
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Looks for the child of a node that holds a char
+	* \param  subNode	Node whose children are searched
+	*         c         Char being looked for
+	* \return           Index of the child node. ROOT if there is no such child
+	*/
+	NodeIndex findChild(NodeIndex subNode, char c) const;
+
+	/**
+	* \brief			Creates an empty bucket and links it as a child of a node
+	* \param  subNode	Node that gets the new child
+	*         c         Char the new child holds
+	* \return           Index of the new child node
+	*/
+	NodeIndex addChild(NodeIndex subNode, char c);
+
+	/**
+	* \brief			Gives out a node, a free one if there is one
+	* \return           Index of the node
+	* \throws			std::length_error if nodes_ would outgrow a NodeIndex
+	*/
+	NodeIndex newNode();
+
+	/**
+	* \brief			Puts a node that no edge leads to on the free list
+	*					 and gives back its bucket or edge block
+	* \param  subNode	Node being freed
+	*/
+	void freeNode(NodeIndex subNode);
+
+	/**
+	* \brief			Walks the trie nodes along a word
+	* \param  word	    Word being followed
+	*         pos       Set to how much of word was used up
+	* \return           Trie node where word ends, or the bucket that holds
+	*					 the rest of word. ROOT if a char is missing
+	*/
+	NodeIndex descend(const std::string& word, size_t& pos) const;
+
+	/**
+	* \brief			Turns a bucket into a trie node with one bucket per char
+	* \param  subNode	Bucket being burst
+	* \note				New buckets that are still too big burst too
+	*/
+	void burst(NodeIndex subNode);
+
+	/**
+	* \brief			Adds every word below a node to output
+	* \param  subNode	Node whose words are collected
+	*         currWord  Word spelled by the path to subNode
+	*		  output    A vector that gets the words
+	*/
+	void collectWords(NodeIndex subNode, const std::string& currWord,
+		std::vector<std::string>& output) const;
+
+	/**
+	* \brief			Remove Nodes and buckets that are not part of words
+	* \param  subNode	Which node we are looking for unused words
+	* \return           true if we should keep the subNode
+	*/
+	bool removeUnusedNodes(NodeIndex subNode);
+
+	/**
+	* \brief			Counts all the nodes being used
+	* \param  subNode	Which node we are counting
+	* \return           Total amount of nodes below subNode
+	*/
+	size_t countAllNodes(NodeIndex subNode) const;
+
+	/// NODE DECLARATION
+	struct Node {
+	public:
+		/**
+		* \brief Default Constructor
+		*/
+		Node();
+
+	private:
+		friend class BasicBurstTrie; // BasicBurstTrie can see private data members
+
+		bool endOfString_; // true if a word ends at this node. false otherwise
+		bool isBucket_; // true if the rest of the words are in a bucket
+		uint16_t childCount_; // amount of children, or of suffixes in the bucket
+		uint16_t childCapacity_; // amount of edges reserved for children
+		uint32_t children_; // offset in edges_ of the first child, or index in buckets_
+	};
+
+	/// EDGE DECLARATION
+	struct Edge {
+		char key_; // char held by the child
+		NodeIndex node_; // child node
+	};
+
+	/// Index of the root node. Also used to mean "no child" since no node
+	///  links back to the root
+	static const NodeIndex ROOT = 0;
+
+	/// private data members
+	std::vector<Node> nodes_; // Node arena. nodes_[ROOT] is the root node and never a bucket
+	std::vector<Edge> edges_; // Child arena. Each node owns a block sorted by key_
+	EdgeBlock::FreeLists freeBlocks_; // Blocks of edges_ no node uses
+	std::vector<Bucket> buckets_; // Suffixes below each bucket node
+	std::vector<uint32_t> freeBuckets_; // Buckets no node uses anymore
+	NodeIndex freeNodes_; // First free node. Free nodes link through children_. ROOT ends the list
+	size_t burstLimit_; // Amount of suffixes a bucket holds before it bursts
+	size_t size_; // Amount of words contained in the trie
+	size_t wordsRemoved_; // Amount of words that have been removed
+};
+
+/// Buckets that are sorted lists of suffixes packed in one string, each
+///  one a length then its chars
+struct SortedBuckets {
+	typedef std::string Bucket;
+	static const size_t LIMIT = BURSTLIMIT;
+
+	static bool add(Bucket& bucket, size_t count, const char* chars, size_t length);
+	static void append(Bucket& bucket, size_t count, const char* chars, size_t length);
+	static bool contains(const Bucket& bucket, const char* chars, size_t length);
+	static bool erase(Bucket& bucket, const char* chars, size_t length);
+	static void collect(const Bucket& bucket, const char* rest, size_t length,
+		std::vector<std::string>& output);
+	static size_t bytes(const Bucket& bucket);
+};
+
+#include "bursttrie-private.hpp"
+
+/// Burst trie with sorted buckets
+typedef BasicBurstTrie<SortedBuckets> BurstTrie;
+
+// compiled once in bursttrie.cpp
+extern template class BasicBurstTrie<SortedBuckets>;
+
+#endif
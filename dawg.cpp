@@ -0,0 +1,275 @@
+/**
+* \file dawg.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for dawg.hpp
+*/
+#include "dawg.hpp"
+#include "edgeblock.hpp"
+#include <stdexcept> // invalid_argument
+
+///////////////////////////////////////////////////////////////
+///////////// Dawg Implementation /////////////////////////////
+///////////////////////////////////////////////////////////////
+
+const Dawg::NodeIndex Dawg::ROOT;
+
+Dawg::Dawg()
+	: nodes_(1, Node{ false, 0, 0 }), edges_{ std::vector<Edge>() }, size_{ 0 }
+{
+	// nothing to do here
+}
+
+Dawg::Dawg(const std::vector<std::string>& words)
+	: Dawg()
+{
+	build(words);
+}
+
+Dawg::Dawg(const Trie& trie)
+	: Dawg()
+{
+	// words come out of the trie sorted and without repeats, one at a
+	//  time, so the trie never has to be listed in full
+	std::vector<BuildState> states(1, BuildState{ false, std::vector<std::pair<char, NodeIndex> >() });
+	std::unordered_map<std::string, NodeIndex> registry;
+	std::string last;
+	trie.forEachCompletion("", [&](std::string word) {
+		add(states, registry, last, word);
+		last = std::move(word);
+		++size_;
+	});
+	finish(states, registry);
+}
+
+bool Dawg::exists(const std::string& word) const
+{
+	if (word.size() == 0) {
+		// empty word is never stored
+		return false;
+	}
+
+	NodeIndex subNode = ROOT;
+	for (auto i = word.begin(); i != word.end(); ++i) {
+		subNode = findChild(subNode, *i);
+		if (subNode == ROOT) {
+			// character not in graph. means word does not exist in graph
+			return false;
+		}
+	}
+	return nodes_[subNode].endOfString_;
+}
+
+std::vector<std::string> Dawg::restOfString(const std::string& prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	// finding our way to the end of the prefix
+	NodeIndex subNode = ROOT;
+	for (auto i = prefix.begin(); i != prefix.end(); ++i) {
+		subNode = findChild(subNode, *i);
+		if (subNode == ROOT) {
+			// character not in graph... no suggestions
+			return output;
+		}
+	}
+
+	std::string currWord = prefix;
+	collectWords(subNode, currWord, output);
+	return output;
+}
+
+size_t Dawg::size() const
+{
+	return size_;
+}
+
+bool Dawg::empty() const
+{
+	return size_ == 0;
+}
+
+size_t Dawg::totalNodes() const
+{
+	return nodes_.size() - 1;
+}
+
+std::ostream& Dawg::print(std::ostream& out) const
+{
+	std::vector<std::string> output = restOfString("");
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+size_t Dawg::memoryUsage() const
+{
+	return sizeof(Dawg) + nodes_.capacity() * sizeof(Node) + edges_.capacity() * sizeof(Edge);
+}
+
+void Dawg::add(std::vector<BuildState>& states,
+	std::unordered_map<std::string, NodeIndex>& registry,
+	const std::string& last, const std::string& word)
+{
+	// follow the prefix word shares with the last word. that path is
+	//  always the last child of each state
+	size_t common = 0;
+	NodeIndex state = ROOT;
+	while (common != last.size() && common != word.size() && last[common] == word[common]) {
+		state = states[state].children_.back().second;
+		++common;
+	}
+
+	// nothing will be added below the rest of the last word. minimize it
+	if (!states[state].children_.empty()) {
+		replaceOrRegister(states, registry, state);
+	}
+
+	// rest of word gets new states
+	for (size_t i = common; i != word.size(); ++i) {
+		NodeIndex next = static_cast<NodeIndex>(states.size());
+		states.push_back(BuildState{ false, std::vector<std::pair<char, NodeIndex> >() });
+		states[state].children_.push_back(std::make_pair(word[i], next));
+		state = next;
+	}
+	states[state].endOfString_ = true;
+}
+
+void Dawg::replaceOrRegister(std::vector<BuildState>& states,
+	std::unordered_map<std::string, NodeIndex>& registry, NodeIndex state)
+{
+	// children have to be minimized before their parent can be compared.
+	//  gather the states along the last path and go back up it
+	std::vector<NodeIndex> path(1, state);
+	NodeIndex below = states[state].children_.back().second;
+	while (!states[below].children_.empty()) {
+		path.push_back(below);
+		below = states[below].children_.back().second;
+	}
+
+	std::string signature;
+	for (auto parent = path.rbegin(); parent != path.rend(); ++parent) {
+		// two states are equivalent when both end words or not and their
+		//  children are the same chars going to the same states
+		NodeIndex child = states[*parent].children_.back().second;
+		const BuildState& current = states[child];
+		signature.assign(1, current.endOfString_ ? '1' : '0');
+		for (auto i = current.children_.begin(); i != current.children_.end(); ++i) {
+			signature.push_back(i->first);
+			signature.append(reinterpret_cast<const char*>(&i->second), sizeof(NodeIndex));
+		}
+
+		auto found = registry.find(signature);
+		if (found != registry.end()) {
+			// use the equivalent state. child is no longer reachable
+			states[*parent].children_.back().second = found->second;
+			states[child].children_ = std::vector<std::pair<char, NodeIndex> >();
+		}
+		else {
+			registry.insert({ signature, child });
+		}
+	}
+}
+
+void Dawg::build(const std::vector<std::string>& words)
+{
+	std::vector<BuildState> states(1, BuildState{ false, std::vector<std::pair<char, NodeIndex> >() });
+	std::unordered_map<std::string, NodeIndex> registry;
+
+	const std::string* last = nullptr;
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		if (i->empty() || (last != nullptr && *i == *last)) {
+			// nothing to add
+			continue;
+		}
+		if (last != nullptr && *i < *last) {
+			throw std::invalid_argument("Dawg words must be sorted");
+		}
+		add(states, registry, (last != nullptr) ? *last : std::string(), *i);
+		last = &*i;
+		++size_;
+	}
+	finish(states, registry);
+}
+
+void Dawg::finish(std::vector<BuildState>& states,
+	std::unordered_map<std::string, NodeIndex>& registry)
+{
+	if (!states[ROOT].children_.empty()) {
+		replaceOrRegister(states, registry, ROOT);
+	}
+
+	// number the states that are still reachable in breadth first order.
+	//  ROOT in newIndex means not numbered yet
+	std::vector<NodeIndex> newIndex(states.size(), ROOT);
+	std::vector<NodeIndex> order(1, ROOT);
+	for (size_t i = 0; i != order.size(); ++i) {
+		const BuildState& state = states[order[i]];
+		for (auto child = state.children_.begin(); child != state.children_.end(); ++child) {
+			if (newIndex[child->second] == ROOT) {
+				newIndex[child->second] = static_cast<NodeIndex>(order.size());
+				order.push_back(child->second);
+			}
+		}
+	}
+
+	// copy them into the compact arrays
+	nodes_.clear();
+	edges_.clear();
+	for (auto i = order.begin(); i != order.end(); ++i) {
+		const BuildState& state = states[*i];
+		Node node = { state.endOfString_, static_cast<uint16_t>(state.children_.size()),
+			static_cast<uint32_t>(edges_.size()) };
+		nodes_.push_back(node);
+		for (auto child = state.children_.begin(); child != state.children_.end(); ++child) {
+			edges_.push_back(Edge{ child->first, newIndex[child->second] });
+		}
+	}
+	nodes_.shrink_to_fit();
+	edges_.shrink_to_fit();
+}
+
+Dawg::NodeIndex Dawg::findChild(NodeIndex subNode, char c) const
+{
+	const Node& node = nodes_[subNode];
+	size_t found = EdgeBlock::find(edges_, node.children_, node.childCount_, c);
+	return (found != edges_.size()) ? edges_[found].node_ : ROOT;
+}
+
+void Dawg::collectWords(NodeIndex subNode, std::string& currWord,
+	std::vector<std::string>& output) const
+{
+	// edges still to follow. a block is sorted by char and goes on the
+	//  stack last first, so words come out sorted
+	struct Pending {
+		size_t edge_; // edge being followed
+		size_t depth_; // length of the path to its node below subNode
+	};
+	std::vector<Pending> pending;
+	size_t base = currWord.size();
+	size_t depth = 0;
+	while (true) {
+		const Node& node = nodes_[subNode];
+		for (size_t i = node.children_ + node.childCount_; i != node.children_; --i) {
+			pending.push_back(Pending{ i - 1, depth + 1 });
+		}
+		if (pending.empty()) {
+			break;
+		}
+
+		Pending current = pending.back();
+		pending.pop_back();
+		const Edge& edge = edges_[current.edge_];
+		currWord.resize(base + current.depth_ - 1);
+		currWord.push_back(edge.key_);
+		if (nodes_[edge.node_].endOfString_) {
+			output.push_back(currWord);
+		}
+		subNode = edge.node_;
+		depth = current.depth_;
+	}
+	currWord.resize(base);
+}
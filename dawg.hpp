@@ -0,0 +1,182 @@
+/**
+* \file dawg.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for Dawg, a minimal acyclic word graph
+*
+*/
+
+// include gaurds
+#ifndef DAWG_HPP_INCLUDED
+#define DAWG_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include <unordered_map>
+#include "trie.hpp"
+
+/// Read-only word set where words share suffixes as well as prefixes.
+///  Built from sorted words with the incremental algorithm of Daciuk,
+///  Mihov, Watson and Watson: once a word is added, every state the next
+///  word cannot reach is merged with an equivalent state seen before
+class Dawg {
+private:
+	struct Node;
+	struct Edge;
+	struct BuildState;
+	typedef uint32_t NodeIndex; // position of a node inside nodes_
+public:
+	/**
+	* \brief Default Constructor to create an empty graph
+	*/
+	Dawg();
+
+	/**
+	* \brief			Builds the graph of a list of words
+	* \param  words	    Words in increasing order. Repeats and empty words
+	*					 are skipped
+	* \throws			std::invalid_argument if words are out of order
+	*/
+	explicit Dawg(const std::vector<std::string>& words);
+
+	/**
+	* \brief			Builds the graph of the words in a trie
+	* \param  trie	    Trie being copied. Later changes to it are not seen
+	*/
+	explicit Dawg(const Trie& trie);
+
+	/**
+	* \brief			Check if a string exists in the graph
+	* \param  word	    Word being checked in the graph
+	* \return			true if word is in the graph. false otherwise
+	*/
+	bool exists(const std::string& word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	* \note				Same words, in the same order, as Trie::restOfString
+	*/
+	std::vector<std::string> restOfString(const std::string& prefix) const;
+
+	/**
+	* \brief			Gives the size of the graph
+	* \return			Amount of strings in graph
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if graph is empty
+	* \return			true if graph is empty. false otherwise
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total amount of nodes in the graph
+	* \note             Root Node does not count as node. Shared nodes
+	*					 count once
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out the words in the graph
+	* \param  out		Where to print graph
+	* \return		    ostream with words in graph
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the graph
+	* \return			Size of the object plus its node and edge arrays
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Adds a word that comes after every word added so far
+	* \param  states	States built so far
+	*         registry  Minimized states, by signature
+	*         last      Word added before word
+	*         word      Word being added
+	*/
+	void add(std::vector<BuildState>& states,
+		std::unordered_map<std::string, NodeIndex>& registry,
+		const std::string& last, const std::string& word);
+
+	/**
+	* \brief			Merges the states along the last path below a state
+	*					 with equivalent states seen before
+	* \param  states	States built so far
+	*         registry  Minimized states, by signature
+	*         state     State whose last child is minimized
+	*/
+	void replaceOrRegister(std::vector<BuildState>& states,
+		std::unordered_map<std::string, NodeIndex>& registry, NodeIndex state);
+
+	/**
+	* \brief			Builds the graph of sorted words
+	* \param  words	    Words in increasing order
+	*/
+	void build(const std::vector<std::string>& words);
+
+	/**
+	* \brief			Minimizes the states of the last word and copies the
+	*					 reachable states into nodes_ and edges_
+	* \param  states	States built so far
+	*         registry  Minimized states, by signature
+	*/
+	void finish(std::vector<BuildState>& states,
+		std::unordered_map<std::string, NodeIndex>& registry);
+
+	/**
+	* \brief			Looks for the child of a node that holds a char
+	* \param  subNode	Node whose children are searched
+	*         c         Char being looked for
+	* \return           Index of the child node. ROOT if there is no such child
+	*/
+	NodeIndex findChild(NodeIndex subNode, char c) const;
+
+	/**
+	* \brief			Adds every word below a node to output
+	* \param  subNode	Node whose words are collected
+	*         currWord  Word spelled by the path to subNode
+	*		  output    A vector that gets the words
+	*/
+	void collectWords(NodeIndex subNode, std::string& currWord,
+		std::vector<std::string>& output) const;
+
+	/// State of the graph while it is being built
+	struct BuildState {
+		bool endOfString_; // true if a word ends here
+		std::vector<std::pair<char, NodeIndex> > children_; // sorted by char
+	};
+
+	/// NODE DECLARATION
+	struct Node {
+		bool endOfString_; // true if a node represents end of string. false otherwise
+		uint16_t childCount_; // amount of children
+		uint32_t children_; // offset in edges_ of the first child
+	};
+
+	/// EDGE DECLARATION
+	struct Edge {
+		char key_; // char held by the child
+		NodeIndex node_; // child node
+	};
+
+	/// Index of the root node. Also used to mean "no child" since no node
+	///  links back to the root
+	static const NodeIndex ROOT = 0;
+
+	/// private data members
+	std::vector<Node> nodes_; // nodes_[ROOT] is the root node
+	std::vector<Edge> edges_; // children of each node, sorted by key_
+	size_t size_; // Amount of words contained in the graph
+};
+
+#endif
@@ -0,0 +1,245 @@
+/**
+* \file edgeblock.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Child blocks and suffix entries shared by the arena based tries
+*
+*/
+
+// include gaurds
+#ifndef EDGEBLOCK_HPP_INCLUDED
+#define EDGEBLOCK_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <algorithm> // copy
+#include <stdexcept> // length_error
+#include <cstddef>
+#include <cstdint>
+
+/// Children of a node kept as a block of edges in one arena that every
+///  node shares. A block is sorted by the key char of its edges. A full
+///  block moves to a block with twice the room, and the block it leaves
+///  goes on a free list for the next block of that size. An edge type
+///  only needs to be copyable; its key comes from a key_ member unless a
+///  KeyOf is given
+struct EdgeBlock {
+	/// Released blocks by capacity. Capacities are powers of two and a
+	///  block never needs room for more than 256 edges
+	struct FreeLists {
+		std::vector<uint32_t> blocks_[9]; // blocks_[i] has the offsets of blocks with room for 1 << i edges
+	};
+
+	/// Key of an edge with a char key_ member
+	struct Key {
+		template <typename Edge>
+		char operator()(const Edge& edge) const
+		{
+			return edge.key_;
+		}
+	};
+
+	/**
+	* \brief			Looks for the edge of a block that holds a char
+	* \param  edges		Edge arena
+	*         first     Offset of the block in edges
+	*         count     Amount of edges in use
+	*         c         Char being looked for
+	*         keyOf     Gives the key char of an edge
+	* \return			Offset of the edge. edges.size() if there is none
+	*/
+	template <typename Edge, typename KeyOf = Key>
+	static size_t find(const std::vector<Edge>& edges, size_t first, size_t count, char c,
+		KeyOf keyOf = KeyOf())
+	{
+		// blocks are small and sorted so a linear scan is cheapest
+		unsigned char key = static_cast<unsigned char>(c);
+		for (size_t i = first; i != first + count; ++i) {
+			unsigned char current = static_cast<unsigned char>(keyOf(edges[i]));
+			if (current == key) {
+				return i;
+			}
+			if (current > key) {
+				// went past where char would be
+				break;
+			}
+		}
+		return edges.size();
+	}
+
+	/**
+	* \brief			Hands out a block, a released one if there is one of
+	*					 this capacity
+	* \param  edges		Edge arena. Grows when no block is free
+	*         free      Released blocks
+	*         capacity  Amount of edges the block needs room for. A power of two
+	* \return			Offset of the block
+	* \throws			std::length_error if the arena no longer fits in
+	*					 32-bit offsets
+	*/
+	template <typename Edge>
+	static uint32_t allocate(std::vector<Edge>& edges, FreeLists& free, uint16_t capacity)
+	{
+		std::vector<uint32_t>& blocks = free.blocks_[sizeClass(capacity)];
+		if (!blocks.empty()) {
+			uint32_t block = blocks.back();
+			blocks.pop_back();
+			return block;
+		}
+
+		// nothing to reuse. grow the arena while offsets still fit
+		size_t offset = edges.size();
+		if (offset + capacity > UINT32_MAX) {
+			throw std::length_error("Edge blocks no longer fit in 32-bit offsets");
+		}
+		edges.resize(offset + capacity);
+		return static_cast<uint32_t>(offset);
+	}
+
+	/**
+	* \brief			Gives a block back so allocate can hand it out again
+	* \param  free      Released blocks
+	*         first     Offset of the block
+	*         capacity  Amount of edges reserved. 0 means there is no block
+	*/
+	static void release(FreeLists& free, uint32_t first, uint16_t capacity)
+	{
+		if (capacity != 0) {
+			free.blocks_[sizeClass(capacity)].push_back(first);
+		}
+	}
+
+	/**
+	* \brief			Copies the edges of a block into a block of their own
+	* \param  edges		Edge arena
+	*         free      Released blocks
+	*         from      Offset of the block being copied
+	*         count     Amount of edges in use
+	*         first     Gets the offset of the copy
+	*         capacity  Gets the amount of edges reserved. 0 if count is 0
+	* \throws			std::length_error if the arena no longer fits in
+	*					 32-bit offsets
+	*/
+	template <typename Edge>
+	static void copy(std::vector<Edge>& edges, FreeLists& free, uint32_t from, uint16_t count,
+		uint32_t& first, uint16_t& capacity)
+	{
+		capacity = 0;
+		first = 0;
+		if (count == 0) {
+			return;
+		}
+		capacity = 1;
+		while (capacity < count) {
+			capacity = static_cast<uint16_t>(capacity * 2);
+		}
+		first = allocate(edges, free, capacity);
+		std::copy(edges.begin() + from, edges.begin() + from + count, edges.begin() + first);
+	}
+
+	/**
+	* \brief			Puts an edge into a block in key order
+	* \param  edges		Edge arena
+	*         free      Released blocks. Gets the block left behind by a move
+	*         first     Offset of the block. Changes if the block moves
+	*         count     Amount of edges in use. Goes up by one
+	*         capacity  Amount of edges reserved. Doubles when the block moves
+	*         edge      Edge being added. No edge of the block has its key
+	*         keyOf     Gives the key char of an edge
+	* \throws			std::length_error if the arena no longer fits in
+	*					 32-bit offsets
+	*/
+	template <typename Edge, typename KeyOf = Key>
+	static void insert(std::vector<Edge>& edges, FreeLists& free, uint32_t& first, uint16_t& count,
+		uint16_t& capacity, const Edge& edge, KeyOf keyOf = KeyOf())
+	{
+		if (count == capacity) {
+			// block is full. move it to a block with twice the room
+			uint16_t grown = static_cast<uint16_t>((capacity == 0) ? 1 : capacity * 2);
+			uint32_t offset = allocate(edges, free, grown);
+			std::copy(edges.begin() + first, edges.begin() + first + count, edges.begin() + offset);
+			release(free, first, capacity);
+			first = offset;
+			capacity = grown;
+		}
+
+		// shift bigger keys over by one and put the edge in its place
+		size_t i = first + count;
+		unsigned char key = static_cast<unsigned char>(keyOf(edge));
+		while (i != first && static_cast<unsigned char>(keyOf(edges[i - 1])) > key) {
+			edges[i] = edges[i - 1];
+			--i;
+		}
+		edges[i] = edge;
+		++count;
+	}
+
+private:
+	/**
+	* \brief			Finds the free list of a capacity
+	* \param  capacity  A power of two up to 256
+	* \return			log2 of capacity
+	*/
+	static size_t sizeClass(uint16_t capacity)
+	{
+		size_t log = 0;
+		while ((1u << log) < capacity) {
+			++log;
+		}
+		return log;
+	}
+};
+
+/// Suffixes kept one after another in a string. Each entry is the length
+///  of the suffix in 7 bit groups, lowest group first with the high bit
+///  set on every group but the last, followed by the chars
+struct SuffixEntry {
+	/**
+	* \brief			Writes a suffix into a string of entries
+	* \param  entries	String being added to
+	*         at        Where the entry goes. entries.size() appends it
+	*         chars     First char of the suffix. Must not point into entries
+	*         length    Length of the suffix
+	* \return			Bytes written
+	*/
+	static size_t write(std::string& entries, size_t at, const char* chars, size_t length)
+	{
+		char prefix[(sizeof(size_t) * 8 + 6) / 7];
+		size_t used = 0;
+		size_t left = length;
+		do {
+			unsigned char group = static_cast<unsigned char>(left & 0x7f);
+			left >>= 7;
+			prefix[used++] = static_cast<char>(group | (left != 0 ? 0x80 : 0));
+		} while (left != 0);
+
+		// make room once, then fill it in
+		entries.insert(at, used + length, '\0');
+		std::copy(prefix, prefix + used, entries.begin() + at);
+		std::copy(chars, chars + length, entries.begin() + at + used);
+		return used + length;
+	}
+
+	/**
+	* \brief			Reads the length of a suffix
+	* \param  entries	String being read
+	*         pos       Start of the entry. Moved to the first char of the suffix
+	* \return			Length of the suffix
+	*/
+	static size_t readLength(const std::string& entries, size_t& pos)
+	{
+		size_t length = 0;
+		unsigned shift = 0;
+		unsigned char group;
+		do {
+			group = static_cast<unsigned char>(entries[pos]);
+			length |= static_cast<size_t>(group & 0x7f) << shift;
+			shift += 7;
+			++pos;
+		} while (group & 0x80);
+		return length;
+	}
+};
+
+#endif
@@ -0,0 +1,251 @@
+/**
+* \file frozentrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for frozentrie.hpp
+*/
+#include "frozentrie.hpp"
+#include <stdexcept> // length_error
+
+///////////////////////////////////////////////////////////////
+///////////// FrozenTrie Implementation ///////////////////////
+///////////////////////////////////////////////////////////////
+
+const int32_t FrozenTrie::ENDCODE;
+const int32_t FrozenTrie::NONE;
+
+FrozenTrie::FrozenTrie()
+	: units_(1, Unit{ 0, NONE, ENDCODE, ENDCODE }), size_{ 0 }
+{
+	// nothing to do here
+}
+
+FrozenTrie::FrozenTrie(const Trie& trie)
+	: FrozenTrie()
+{
+	size_ = trie.size();
+	if (size_ != 0) {
+		std::vector<bool> usedBase;
+		std::vector<size_t> nextFree(1, 1);
+		build(trie, usedBase, nextFree);
+	}
+
+	// drop the free units at the end. child() checks the bounds
+	size_t last = units_.size();
+	while (last > 1 && units_[last - 1].check_ == NONE) {
+		--last;
+	}
+	units_.resize(last);
+	units_.shrink_to_fit();
+}
+
+bool FrozenTrie::exists(const std::string& word) const
+{
+	if (word.size() == 0) {
+		// empty word is never stored
+		return false;
+	}
+
+	// follow one transition per char, then the end of word transition
+	int32_t state = 0;
+	for (auto i = word.begin(); i != word.end() && state != NONE; ++i) {
+		state = child(state, static_cast<unsigned char>(*i) + 1);
+	}
+	return state != NONE && child(state, ENDCODE) != NONE;
+}
+
+std::vector<std::string> FrozenTrie::restOfString(const std::string& prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	// finding our way to the end of the prefix
+	int32_t state = 0;
+	for (auto i = prefix.begin(); i != prefix.end(); ++i) {
+		state = child(state, static_cast<unsigned char>(*i) + 1);
+		if (state == NONE) {
+			// character not in trie... no suggestions
+			return output;
+		}
+	}
+
+	std::string currWord = prefix;
+	collectWords(state, currWord, output);
+	return output;
+}
+
+size_t FrozenTrie::size() const
+{
+	return size_;
+}
+
+bool FrozenTrie::empty() const
+{
+	return size_ == 0;
+}
+
+std::ostream& FrozenTrie::print(std::ostream& out) const
+{
+	std::vector<std::string> output = restOfString("");
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+size_t FrozenTrie::memoryUsage() const
+{
+	return sizeof(FrozenTrie) + units_.capacity() * sizeof(Unit);
+}
+
+void FrozenTrie::build(const Trie& trie, std::vector<bool>& usedBase,
+	std::vector<size_t>& nextFree)
+{
+	// nodes left behind by removed words lead to no word and are skipped
+	std::vector<bool> used = trie.usedNodes(trie.root_);
+
+	// states waiting for their children, with the node they stand for.
+	//  the first child is placed first, then everything below it
+	struct Pending {
+		int32_t state_;
+		Trie::NodeIndex node_;
+	};
+	std::vector<Pending> pending = { Pending{ 0, trie.root_ } };
+	std::vector<int32_t> codes;
+	std::vector<Trie::NodeIndex> children;
+	while (!pending.empty()) {
+		Pending current = pending.back();
+		pending.pop_back();
+
+		// codes of the children in char order. end of word comes first
+		codes.clear();
+		children.clear();
+		if (trie.isEndOfString(current.node_)) {
+			codes.push_back(ENDCODE);
+		}
+		trie.forEachChild(current.node_, [&](unsigned char key, Trie::NodeIndex child) {
+			if (used[child]) {
+				codes.push_back(static_cast<int32_t>(key) + 1);
+				children.push_back(child);
+			}
+		});
+
+		// claim a unit for every child and link the char children
+		int32_t base = findBase(codes, usedBase, nextFree);
+		units_[current.state_].base_ = base;
+		usedBase[base] = true;
+		uint16_t* link = &units_[current.state_].firstCode_;
+		for (auto i = codes.begin(); i != codes.end(); ++i) {
+			units_[base + *i].check_ = current.state_;
+			nextFree[base + *i] = base + *i + 1;
+			if (*i != ENDCODE) {
+				*link = static_cast<uint16_t>(*i);
+				link = &units_[base + *i].nextCode_;
+			}
+		}
+
+		// last child goes on first so the first child comes off first
+		size_t child = children.size();
+		for (auto i = codes.rbegin(); child != 0; ++i) {
+			--child;
+			pending.push_back(Pending{ base + *i, children[child] });
+		}
+	}
+}
+
+int32_t FrozenTrie::findBase(const std::vector<int32_t>& codes, std::vector<bool>& usedBase,
+	std::vector<size_t>& nextFree)
+{
+	// try to put the smallest code in each free unit, skipping taken ones
+	size_t pos = freeUnit(nextFree, static_cast<size_t>(codes.front()) + 1);
+	while (true) {
+		if (pos + 257 > static_cast<size_t>(INT32_MAX)) {
+			throw std::length_error("FrozenTrie has more units than an int32_t can address");
+		}
+		if (pos + 257 > units_.size()) {
+			// make room for any code at this base
+			units_.resize(pos + 257, Unit{ 0, NONE, ENDCODE, ENDCODE });
+			usedBase.resize(units_.size(), false);
+			while (nextFree.size() < units_.size()) {
+				nextFree.push_back(nextFree.size());
+			}
+		}
+		if (units_[pos].check_ == NONE) {
+			size_t base = pos - codes.front();
+			bool fits = !usedBase[base];
+			for (auto i = codes.begin() + 1; fits && i != codes.end(); ++i) {
+				fits = units_[base + *i].check_ == NONE;
+			}
+			if (fits) {
+				return static_cast<int32_t>(base);
+			}
+		}
+		pos = freeUnit(nextFree, pos + 1);
+	}
+}
+
+size_t FrozenTrie::freeUnit(std::vector<size_t>& nextFree, size_t unit)
+{
+	// follow the skips to a free unit. units past the end are free
+	size_t found = unit;
+	while (found < nextFree.size() && nextFree[found] != found) {
+		found = nextFree[found];
+	}
+
+	// point every unit passed over straight at it
+	while (unit < nextFree.size() && nextFree[unit] != unit) {
+		size_t next = nextFree[unit];
+		nextFree[unit] = found;
+		unit = next;
+	}
+	return found;
+}
+
+int32_t FrozenTrie::child(int32_t state, int32_t code) const
+{
+	size_t next = static_cast<size_t>(units_[state].base_) + code;
+	if (next < units_.size() && units_[next].check_ == state) {
+		return static_cast<int32_t>(next);
+	}
+	return NONE;
+}
+
+void FrozenTrie::collectWords(int32_t state, std::string& currWord,
+	std::vector<std::string>& output) const
+{
+	// states still to visit. char children are linked in char order and
+	//  go on the stack last first, so words come out sorted
+	struct Pending {
+		int32_t state_; // state being visited
+		size_t depth_; // length of the path to state_ below state
+	};
+	std::vector<Pending> pending;
+	std::vector<int32_t> children;
+	size_t base = currWord.size();
+	Pending current = { state, 0 };
+	while (true) {
+		children.clear();
+		int32_t first = units_[current.state_].base_;
+		for (int32_t code = units_[current.state_].firstCode_; code != ENDCODE; code = units_[first + code].nextCode_) {
+			children.push_back(first + code);
+		}
+		for (auto i = children.rbegin(); i != children.rend(); ++i) {
+			pending.push_back(Pending{ *i, current.depth_ + 1 });
+		}
+		if (pending.empty()) {
+			break;
+		}
+
+		// the char of a state is how far it is from the base of its parent
+		current = pending.back();
+		pending.pop_back();
+		int32_t code = current.state_ - units_[units_[current.state_].check_].base_;
+		currWord.resize(base + current.depth_ - 1);
+		currWord.push_back(static_cast<char>(code - 1));
+		if (child(current.state_, ENDCODE) != NONE) {
+			output.push_back(currWord);
+		}
+	}
+	currWord.resize(base);
+}
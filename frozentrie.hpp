@@ -0,0 +1,143 @@
+/**
+* \file frozentrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for FrozenTrie, a read-only double-array trie
+*
+*/
+
+// include gaurds
+#ifndef FROZENTRIE_HPP_INCLUDED
+#define FROZENTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include "trie.hpp"
+
+/// Read-only copy of a Trie stored as a double-array (BASE/CHECK).
+///  State s goes to state t = base_ of s + code of char when check_ of t
+///  is s, so every step is two array reads and no pointers are followed
+class FrozenTrie {
+public:
+	/**
+	* \brief Default Constructor to create an empty frozen trie
+	*/
+	FrozenTrie();
+
+	/**
+	* \brief			Compiles the words of a trie into a double-array
+	* \param  trie	    Trie being frozen. Later changes to it are not seen
+	* \throws			std::length_error if the units no longer fit in
+	*					 int32_t offsets
+	*/
+	explicit FrozenTrie(const Trie& trie);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(const std::string& word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	* \note				Same words, in the same order, as Trie::restOfString
+	*/
+	std::vector<std::string> restOfString(const std::string& prefix) const;
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if trie is empty
+	* \return			true if trie is empty. false otherwise
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print trie
+	* \return		    ostream with words in trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the object plus its BASE/CHECK array
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Places the states of every node that leads to a word,
+	*					 a node and then the nodes below it
+	* \param  trie	    Trie being frozen
+	*         usedBase  Bases already taken by a state
+	*         nextFree  Skips from each taken unit toward a free one
+	*/
+	void build(const Trie& trie, std::vector<bool>& usedBase, std::vector<size_t>& nextFree);
+
+	/**
+	* \brief			Finds a base where every code fits in a free unit
+	* \param  codes	    Sorted codes of the children being placed
+	*         usedBase  Bases already taken by a state. Grows with units_
+	*         nextFree  Skips from each taken unit toward a free one. Grows with units_
+	* \return			The base. Units are added when needed
+	*/
+	int32_t findBase(const std::vector<int32_t>& codes, std::vector<bool>& usedBase,
+		std::vector<size_t>& nextFree);
+
+	/**
+	* \brief			Finds the first free unit at or after a unit, shortening
+	*					 the skips it follows
+	* \param  nextFree  Skips from each taken unit toward a free one
+	*         unit      Where the search starts
+	* \return			The free unit. May be past the end of units_
+	*/
+	static size_t freeUnit(std::vector<size_t>& nextFree, size_t unit);
+
+	/**
+	* \brief			Follows one transition
+	* \param  state	    State being left
+	*         code      Code of the transition. 0 is the end of a word
+	* \return			The state reached. NONE if there is no such transition
+	*/
+	int32_t child(int32_t state, int32_t code) const;
+
+	/**
+	* \brief			Adds every word below a state to output
+	* \param  state	    State whose words are collected
+	*         currWord  Word spelled by the path to state
+	*		  output    A vector that gets the words
+	*/
+	void collectWords(int32_t state, std::string& currWord,
+		std::vector<std::string>& output) const;
+
+	/// UNIT DECLARATION
+	struct Unit {
+		int32_t base_; // children of this state start at base_ + code
+		int32_t check_; // parent of this state. NONE if unit is free
+		uint16_t firstCode_; // code of the first char child. ENDCODE if there is none
+		uint16_t nextCode_; // code of the next char child of the parent. ENDCODE if last
+	};
+
+	/// Code of the end of word transition. Chars use their value plus one
+	static const int32_t ENDCODE = 0;
+
+	/// Marks a free unit, a missing transition and the parent of the root
+	static const int32_t NONE = -1;
+
+	/// private data members
+	std::vector<Unit> units_; // BASE/CHECK array. units_[0] is the root
+	size_t size_; // Amount of words contained in the trie
+};
+
+#endif
@@ -0,0 +1,155 @@
+/**
+* \file hattrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for the hash buckets of hattrie.hpp. Compiles
+*		 HatTrie once for every file that includes hattrie.hpp
+*/
+#include "hattrie.hpp"
+#include <algorithm> // sort
+
+namespace {
+	/// Average amount of suffixes per slot before a table doubles its slots
+	const size_t SLOTLOAD = 8;
+
+	/// Most slots a table gets. Past this slots just get longer until the
+	///  bucket bursts
+	const size_t MAXSLOTS = 512;
+
+	/**
+	* \brief			Hashes a suffix
+	* \param  chars     First char of the suffix
+	*         length    Length of the suffix
+	* \return			FNV-1a hash of the suffix
+	*/
+	uint32_t hashOf(const char* chars, size_t length)
+	{
+		uint32_t hash = 2166136261u;
+		for (size_t i = 0; i != length; ++i) {
+			hash ^= static_cast<unsigned char>(chars[i]);
+			hash *= 16777619u;
+		}
+		return hash;
+	}
+
+	/**
+	* \brief			Looks for a suffix in a slot
+	* \param  slot		Slot being searched
+	*         chars     First char of the suffix
+	*         length    Length of the suffix
+	*         entry     Set to where the entry starts if it is found
+	* \return			true if the suffix is in the slot
+	*/
+	bool findEntry(const std::string& slot, const char* chars, size_t length, size_t& entry)
+	{
+		size_t pos = 0;
+		while (pos != slot.size()) {
+			entry = pos;
+			size_t current = SuffixEntry::readLength(slot, pos);
+			// lengths are compared first so most entries are skipped cheaply
+			if (current == length && slot.compare(pos, length, chars, length) == 0) {
+				return true;
+			}
+			pos += current;
+		}
+		return false;
+	}
+}
+
+///////////////////////////////////////////////////////////////
+///////////// HashBuckets Implementation //////////////////////
+///////////////////////////////////////////////////////////////
+
+const size_t HashBuckets::LIMIT;
+
+bool HashBuckets::add(Bucket& bucket, size_t count, const char* chars, size_t length)
+{
+	if (bucket.empty()) {
+		bucket.resize(1);
+	}
+	std::string& slot = bucket[hashOf(chars, length) & (bucket.size() - 1)];
+	size_t entry;
+	if (findEntry(slot, chars, length, entry)) {
+		return false;
+	}
+	SuffixEntry::write(slot, slot.size(), chars, length);
+
+	if (count + 1 > bucket.size() * SLOTLOAD && bucket.size() < MAXSLOTS) {
+		// slots are getting long. spread the suffixes over twice as many
+		Bucket bigger(bucket.size() * 2);
+		for (auto i = bucket.begin(); i != bucket.end(); ++i) {
+			size_t pos = 0;
+			while (pos != i->size()) {
+				size_t current = SuffixEntry::readLength(*i, pos);
+				const char* start = i->data() + pos;
+				std::string& moved = bigger[hashOf(start, current) & (bigger.size() - 1)];
+				SuffixEntry::write(moved, moved.size(), start, current);
+				pos += current;
+			}
+		}
+		bucket.swap(bigger);
+	}
+	return true;
+}
+
+void HashBuckets::append(Bucket& bucket, size_t count, const char* chars, size_t length)
+{
+	// tables keep no order. a new suffix goes where it hashes to
+	add(bucket, count, chars, length);
+}
+
+bool HashBuckets::contains(const Bucket& bucket, const char* chars, size_t length)
+{
+	// suffix can only be in the slot it hashes to
+	if (bucket.empty()) {
+		return false;
+	}
+	size_t entry;
+	return findEntry(bucket[hashOf(chars, length) & (bucket.size() - 1)], chars, length, entry);
+}
+
+bool HashBuckets::erase(Bucket& bucket, const char* chars, size_t length)
+{
+	if (bucket.empty()) {
+		return false;
+	}
+	std::string& slot = bucket[hashOf(chars, length) & (bucket.size() - 1)];
+	size_t entry;
+	if (!findEntry(slot, chars, length, entry)) {
+		return false;
+	}
+	size_t end = entry;
+	end += SuffixEntry::readLength(slot, end);
+	slot.erase(entry, end - entry);
+	return true;
+}
+
+void HashBuckets::collect(const Bucket& bucket, const char* rest, size_t length,
+	std::vector<std::string>& output)
+{
+	// the longer suffixes that start with rest can be in any slot
+	size_t first = output.size();
+	for (auto slot = bucket.begin(); slot != bucket.end(); ++slot) {
+		size_t entry = 0;
+		while (entry != slot->size()) {
+			size_t current = SuffixEntry::readLength(*slot, entry);
+			if (current > length && slot->compare(entry, length, rest, length) == 0) {
+				output.push_back(slot->substr(entry, current));
+			}
+			entry += current;
+		}
+	}
+	std::sort(output.begin() + first, output.end());
+}
+
+size_t HashBuckets::bytes(const Bucket& bucket)
+{
+	size_t bytes = bucket.capacity() * sizeof(std::string);
+	for (auto slot = bucket.begin(); slot != bucket.end(); ++slot) {
+		bytes += slot->capacity();
+	}
+	return bytes;
+}
+
+template class BasicBurstTrie<HashBuckets>;
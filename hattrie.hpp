@@ -0,0 +1,46 @@
+/**
+* \file hattrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for HatTrie, a trie with array hash tables at its leaves
+*
+*/
+
+// include gaurds
+#ifndef HATTRIE_HPP_INCLUDED
+#define HATTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include "bursttrie.hpp" // BasicBurstTrie
+
+/// Default amount of suffixes a hash bucket holds before it bursts
+const size_t HATBURSTLIMIT = 4096;
+
+/// Buckets that are array hash tables. Each slot of a table is one
+///  string with the suffixes that hash to it packed one after another, so
+///  a lookup reads one contiguous block instead of chasing pointers.
+///  Tables keep no order, so collect sorts what it finds
+struct HashBuckets {
+	typedef std::vector<std::string> Bucket; // slots. Slot count is a power of two
+	static const size_t LIMIT = HATBURSTLIMIT;
+
+	static bool add(Bucket& bucket, size_t count, const char* chars, size_t length);
+	static void append(Bucket& bucket, size_t count, const char* chars, size_t length);
+	static bool contains(const Bucket& bucket, const char* chars, size_t length);
+	static bool erase(Bucket& bucket, const char* chars, size_t length);
+	static void collect(const Bucket& bucket, const char* rest, size_t length,
+		std::vector<std::string>& output);
+	static size_t bytes(const Bucket& bucket);
+};
+
+/// Burst trie whose leaves are array hash tables. A table that grows past
+///  the burst limit is turned into a trie node with one table per first
+///  char. Same operations as Trie
+typedef BasicBurstTrie<HashBuckets> HatTrie;
+
+// compiled once in hattrie.cpp
+extern template class BasicBurstTrie<HashBuckets>;
+
+#endif
@@ -0,0 +1,182 @@
+/**
+* \file loudstrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for loudstrie.hpp
+*/
+#include "loudstrie.hpp"
+
+///////////////////////////////////////////////////////////////
+///////////// LoudsTrie Implementation ////////////////////////
+///////////////////////////////////////////////////////////////
+
+const size_t LoudsTrie::NONE;
+
+LoudsTrie::LoudsTrie()
+	: LoudsTrie(Trie())
+{
+	// nothing to do here
+}
+
+LoudsTrie::LoudsTrie(const Trie& trie)
+	: louds_{ BitVector() }, terminal_{ BitVector() }, labels_{ "" }, size_{ trie.size() }
+{
+	// nodes left behind by removed words lead to no word and are skipped
+	std::vector<bool> used = trie.usedNodes(trie.root_);
+
+	// super root has the root as its only child
+	louds_.push_back(true);
+	louds_.push_back(false);
+
+	// write the nodes one level at a time. children come in char order
+	std::vector<Trie::NodeIndex> level = { trie.root_ };
+	while (!level.empty()) {
+		std::vector<Trie::NodeIndex> nextLevel;
+		for (auto node = level.begin(); node != level.end(); ++node) {
+			terminal_.push_back(trie.isEndOfString(*node));
+			trie.forEachChild(*node, [&](unsigned char key, Trie::NodeIndex child) {
+				if (used[child]) {
+					louds_.push_back(true);
+					labels_.push_back(static_cast<char>(key));
+					nextLevel.push_back(child);
+				}
+			});
+			louds_.push_back(false);
+		}
+		level.swap(nextLevel);
+	}
+
+	louds_.build();
+	terminal_.build();
+	labels_.shrink_to_fit();
+}
+
+bool LoudsTrie::exists(const std::string& word) const
+{
+	if (word.size() == 0) {
+		// empty word is never stored
+		return false;
+	}
+
+	size_t node = 0;
+	for (auto i = word.begin(); i != word.end(); ++i) {
+		node = findChild(node, *i);
+		if (node == NONE) {
+			// character not in trie. means word does not exist in trie
+			return false;
+		}
+	}
+	return terminal_[node];
+}
+
+std::vector<std::string> LoudsTrie::restOfString(const std::string& prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	// finding our way to the end of the prefix
+	size_t node = 0;
+	for (auto i = prefix.begin(); i != prefix.end(); ++i) {
+		node = findChild(node, *i);
+		if (node == NONE) {
+			// character not in trie... no suggestions
+			return output;
+		}
+	}
+
+	std::string currWord = prefix;
+	collectWords(node, currWord, output);
+	return output;
+}
+
+size_t LoudsTrie::size() const
+{
+	return size_;
+}
+
+bool LoudsTrie::empty() const
+{
+	return size_ == 0;
+}
+
+size_t LoudsTrie::totalNodes() const
+{
+	return labels_.size();
+}
+
+std::ostream& LoudsTrie::print(std::ostream& out) const
+{
+	std::vector<std::string> output = restOfString("");
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+size_t LoudsTrie::memoryUsage() const
+{
+	return sizeof(LoudsTrie) + louds_.memoryUsage() + terminal_.memoryUsage()
+		+ labels_.capacity();
+}
+
+size_t LoudsTrie::children(size_t node, size_t& first) const
+{
+	// children of node are the set bits after the (node + 1)-th clear bit.
+	//  the n-th set bit is the child numbered n - 1
+	size_t start = louds_.select0(node + 1) + 1;
+	first = louds_.rank1(start);
+	return louds_.nextZero(start) - start;
+}
+
+size_t LoudsTrie::findChild(size_t node, char c) const
+{
+	// labels of siblings are next to each other and sorted
+	size_t first;
+	size_t count = children(node, first);
+	unsigned char key = static_cast<unsigned char>(c);
+	for (size_t child = first; child != first + count; ++child) {
+		unsigned char current = static_cast<unsigned char>(labels_[child - 1]);
+		if (current == key) {
+			return child;
+		}
+		if (current > key) {
+			// went past where char would be
+			break;
+		}
+	}
+	return NONE;
+}
+
+void LoudsTrie::collectWords(size_t node, std::string& currWord,
+	std::vector<std::string>& output) const
+{
+	// nodes still to visit. children are numbered in label order and go
+	//  on the stack last first, so words come out sorted
+	struct Pending {
+		size_t node_; // node being visited
+		size_t depth_; // length of the path to node_ below node
+	};
+	std::vector<Pending> pending;
+	size_t base = currWord.size();
+	Pending current = { node, 0 };
+	while (true) {
+		size_t first;
+		size_t count = children(current.node_, first);
+		for (size_t child = first + count; child != first; --child) {
+			pending.push_back(Pending{ child - 1, current.depth_ + 1 });
+		}
+		if (pending.empty()) {
+			break;
+		}
+
+		current = pending.back();
+		pending.pop_back();
+		currWord.resize(base + current.depth_ - 1);
+		currWord.push_back(labels_[current.node_ - 1]);
+		if (terminal_[current.node_]) {
+			output.push_back(currWord);
+		}
+	}
+	currWord.resize(base);
+}
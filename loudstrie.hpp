@@ -0,0 +1,122 @@
+/**
+* \file loudstrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for LoudsTrie, a succinct read-only trie
+*
+*/
+
+// include gaurds
+#ifndef LOUDSTRIE_HPP_INCLUDED
+#define LOUDSTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "trie.hpp"
+#include "bitvector.hpp"
+
+/// Read-only copy of a Trie in LOUDS (level-order unary degree sequence)
+///  form. Nodes are numbered in breadth first order with the root as 0.
+///  Each node is written as one set bit per child followed by a clear bit,
+///  so the shape costs about 2 bits per node. One more bit per node marks
+///  the end of words and one byte per node holds its char
+class LoudsTrie {
+public:
+	/**
+	* \brief Default Constructor to create an empty trie
+	*/
+	LoudsTrie();
+
+	/**
+	* \brief			Encodes the words of a trie
+	* \param  trie	    Trie being encoded. Later changes to it are not seen
+	*/
+	explicit LoudsTrie(const Trie& trie);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(const std::string& word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	* \note				Words come out in order, same as Trie::restOfString
+	*/
+	std::vector<std::string> restOfString(const std::string& prefix) const;
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if trie is empty
+	* \return			true if trie is empty. false otherwise
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total amount of nodes in trie
+	* \note             Root Node does not count as node
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print trie
+	* \return		    ostream with words in trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the object plus its bit vectors and labels
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Finds the children of a node
+	* \param  node	    Node whose children are wanted
+	*         first     Set to the number of the first child
+	* \return			Amount of children. Children are numbered
+	*					 first, first + 1, ... in char order
+	*/
+	size_t children(size_t node, size_t& first) const;
+
+	/**
+	* \brief			Looks for the child of a node that holds a char
+	* \param  node	    Node whose children are searched
+	*         c         Char being looked for
+	* \return           Number of the child. NONE if there is no such child
+	*/
+	size_t findChild(size_t node, char c) const;
+
+	/**
+	* \brief			Adds every word below a node to output
+	* \param  node	    Node whose words are collected
+	*         currWord  Word spelled by the path to node
+	*		  output    A vector that gets the words
+	*/
+	void collectWords(size_t node, std::string& currWord,
+		std::vector<std::string>& output) const;
+
+	/// Means there is no such node
+	static const size_t NONE = static_cast<size_t>(-1);
+
+	/// private data members
+	BitVector louds_; // "10" for a super root then the degree of every node in unary
+	BitVector terminal_; // one bit per node. set if a word ends there
+	std::string labels_; // char of every node but the root. labels_[i - 1] is node i
+	size_t size_; // Amount of words contained in the trie
+};
+
+#endif
@@ -0,0 +1,387 @@
+/**
+* \file persistenttrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for persistenttrie.hpp
+*/
+#include "persistenttrie.hpp"
+#include <algorithm> // lower_bound
+#include <utility> // move
+
+///////////////////////////////////////////////////////////////
+///////////// PersistentTrie Implementation ///////////////////
+///////////////////////////////////////////////////////////////
+
+PersistentTrie::PersistentTrie()
+	: root_{ nullptr }, size_{ 0 }
+{
+	// nothing to do here
+}
+
+PersistentTrie::PersistentTrie(const PersistentTrie& other)
+	: root_{ other.root_ }, size_{ other.size_ }
+{
+	// nodes are shared, never copied
+}
+
+PersistentTrie::PersistentTrie(PersistentTrie&& other) noexcept
+	: root_{ std::move(other.root_) }, size_{ other.size_ }
+{
+	other.size_ = 0;
+}
+
+PersistentTrie& PersistentTrie::operator=(const PersistentTrie& other)
+{
+	if (this != &other) {
+		NodePtr old = std::move(root_);
+		root_ = other.root_;
+		size_ = other.size_;
+		release(old);
+	}
+	return *this;
+}
+
+PersistentTrie& PersistentTrie::operator=(PersistentTrie&& other) noexcept
+{
+	if (this != &other) {
+		NodePtr old = std::move(root_);
+		root_ = std::move(other.root_);
+		size_ = other.size_;
+		other.size_ = 0;
+		release(old);
+	}
+	return *this;
+}
+
+PersistentTrie::~PersistentTrie()
+{
+	release(root_);
+}
+
+PersistentTrie PersistentTrie::insert(const std::string& word) const
+{
+	if (word.size() == 0 || exists(word)) {
+		// nothing changes. share this version
+		return *this;
+	}
+
+	PersistentTrie version = PersistentTrie();
+	version.root_ = insert(root_, word);
+	version.size_ = size_ + 1;
+	return version;
+}
+
+PersistentTrie::NodePtr PersistentTrie::insert(const NodePtr& subNode, const std::string& word)
+{
+	// copy every node on the path. they may be part of other versions.
+	//  slots[i] is where path[i + 1] goes in path[i]
+	std::vector<std::shared_ptr<Node> > path;
+	std::vector<size_t> slots;
+	path.reserve(word.size() + 1);
+	slots.reserve(word.size());
+	NodePtr old = subNode;
+	for (size_t pos = 0; pos != word.size(); ++pos) {
+		std::shared_ptr<Node> copy = (old != nullptr) ? std::make_shared<Node>(*old) : std::make_shared<Node>();
+		size_t at = findKey(*copy, word[pos]);
+		if (at != copy->keys_.size() && copy->keys_[at] == word[pos]) {
+			// char is a child already. copy it next
+			old = copy->children_[at];
+		}
+		else {
+			// char not a child yet. add it in order
+			copy->keys_.insert(copy->keys_.begin() + at, word[pos]);
+			copy->children_.insert(copy->children_.begin() + at, nullptr);
+			old = nullptr;
+		}
+		path.push_back(copy);
+		slots.push_back(at);
+	}
+
+	// the whole word is on the path. mark its end
+	path.push_back((old != nullptr) ? std::make_shared<Node>(*old) : std::make_shared<Node>());
+	path.back()->endOfString_ = true;
+
+	// link the copies bottom up
+	for (size_t i = slots.size(); i != 0; --i) {
+		path[i - 1]->children_[slots[i - 1]] = std::move(path[i]);
+	}
+	return path[0];
+}
+
+PersistentTrie PersistentTrie::remove(const std::string& word) const
+{
+	if (!exists(word)) {
+		// nothing changes. share this version
+		return *this;
+	}
+
+	PersistentTrie version = PersistentTrie();
+	version.root_ = remove(root_, word);
+	version.size_ = size_ - 1;
+	return version;
+}
+
+PersistentTrie::NodePtr PersistentTrie::remove(const NodePtr& subNode, const std::string& word)
+{
+	// copy every node on the path. slots[i] is where path[i + 1] is in path[i]
+	std::vector<std::shared_ptr<Node> > path;
+	std::vector<size_t> slots;
+	path.reserve(word.size() + 1);
+	slots.reserve(word.size());
+	path.push_back(std::make_shared<Node>(*subNode));
+	for (size_t pos = 0; pos != word.size(); ++pos) {
+		size_t at = findKey(*path.back(), word[pos]);
+		slots.push_back(at);
+		path.push_back(std::make_shared<Node>(*path.back()->children_[at]));
+	}
+
+	// we reached the end of the word
+	path.back()->endOfString_ = false;
+
+	// link the copies bottom up. a node is kept only if it still leads
+	//  to a word
+	NodePtr below = path.back();
+	if (!path.back()->endOfString_ && path.back()->children_.empty()) {
+		below = nullptr;
+	}
+	for (size_t i = slots.size(); i != 0; --i) {
+		Node& copy = *path[i - 1];
+		if (below != nullptr) {
+			copy.children_[slots[i - 1]] = std::move(below);
+		}
+		else {
+			// child has no words left. drop it
+			copy.keys_.erase(copy.keys_.begin() + slots[i - 1]);
+			copy.children_.erase(copy.children_.begin() + slots[i - 1]);
+		}
+		below = (!copy.endOfString_ && copy.children_.empty()) ? nullptr : path[i - 1];
+	}
+	return below;
+}
+
+bool PersistentTrie::exists(std::string word) const
+{
+	if (word.size() == 0) {
+		return false;
+	}
+
+	// follow the word one char at a time
+	const Node* node = root_.get();
+	for (auto i = word.begin(); i != word.end() && node != nullptr; ++i) {
+		size_t at = findKey(*node, *i);
+		node = (at != node->keys_.size() && node->keys_[at] == *i) ? node->children_[at].get() : nullptr;
+	}
+	return node != nullptr && node->endOfString_;
+}
+
+std::vector<std::string> PersistentTrie::restOfString(std::string prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	// finding our way to the end of the prefix
+	const Node* node = root_.get();
+	for (auto i = prefix.begin(); i != prefix.end() && node != nullptr; ++i) {
+		size_t at = findKey(*node, *i);
+		node = (at != node->keys_.size() && node->keys_[at] == *i) ? node->children_[at].get() : nullptr;
+	}
+	if (node == nullptr) {
+		// character not in trie... no suggestions
+		return output;
+	}
+
+	collectWords(*node, prefix, output);
+	return output;
+}
+
+size_t PersistentTrie::findKey(const Node& subNode, char c)
+{
+	// compare as unsigned chars so words come out in the same order as on a Trie
+	auto found = std::lower_bound(subNode.keys_.begin(), subNode.keys_.end(), c, [](char a, char b) {
+		return static_cast<unsigned char>(a) < static_cast<unsigned char>(b);
+	});
+	return static_cast<size_t>(found - subNode.keys_.begin());
+}
+
+void PersistentTrie::collectWords(const Node& subNode, std::string& currWord,
+	std::vector<std::string>& output)
+{
+	// explicit stack of nodes still to visit, each with the length of the
+	//  word on its path. children go on backwards so words come out in order
+	struct Pending {
+		const Node* node_;
+		char key_;
+		size_t depth_;
+	};
+	std::vector<Pending> pending;
+	size_t start = currWord.size();
+	for (size_t i = subNode.keys_.size(); i != 0; --i) {
+		pending.push_back(Pending{ subNode.children_[i - 1].get(), subNode.keys_[i - 1], 1 });
+	}
+	while (!pending.empty()) {
+		Pending next = pending.back();
+		pending.pop_back();
+		currWord.resize(start + next.depth_ - 1);
+		currWord.push_back(next.key_);
+		if (next.node_->endOfString_) {
+			output.push_back(currWord);
+		}
+		for (size_t i = next.node_->keys_.size(); i != 0; --i) {
+			pending.push_back(Pending{ next.node_->children_[i - 1].get(), next.node_->keys_[i - 1], next.depth_ + 1 });
+		}
+	}
+	currWord.resize(start);
+}
+
+size_t PersistentTrie::countAllNodes(const Node& subNode)
+{
+	size_t count = 0;
+	std::vector<const Node*> pending(1, &subNode);
+	while (!pending.empty()) {
+		const Node* node = pending.back();
+		pending.pop_back();
+		count += node->children_.size();
+		for (auto i = node->children_.begin(); i != node->children_.end(); ++i) {
+			pending.push_back(i->get());
+		}
+	}
+	return count;
+}
+
+size_t PersistentTrie::nodeMemory(const Node& subNode)
+{
+	size_t bytes = 0;
+	std::vector<const Node*> pending(1, &subNode);
+	while (!pending.empty()) {
+		const Node* node = pending.back();
+		pending.pop_back();
+
+		// make_shared puts the two reference counts in front of the node
+		bytes += 2 * sizeof(long) + sizeof(Node) + node->keys_.capacity()
+			+ node->children_.capacity() * sizeof(NodePtr);
+		for (auto i = node->children_.begin(); i != node->children_.end(); ++i) {
+			pending.push_back(i->get());
+		}
+	}
+	return bytes;
+}
+
+size_t PersistentTrie::size() const
+{
+	return size_;
+}
+
+bool PersistentTrie::empty() const
+{
+	return size_ == 0;
+}
+
+size_t PersistentTrie::totalNodes() const
+{
+	return (root_ != nullptr) ? countAllNodes(*root_) : 0;
+}
+
+std::ostream& PersistentTrie::print(std::ostream& out) const
+{
+	// find all the words inside the trie
+	std::vector<std::string> output = restOfString("");
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+size_t PersistentTrie::memoryUsage() const
+{
+	return sizeof(PersistentTrie) + ((root_ != nullptr) ? nodeMemory(*root_) : 0);
+}
+
+void PersistentTrie::release(NodePtr& subNode) noexcept
+{
+	// a node nothing else holds gives up its children before it goes, so
+	//  each node freed here has no children left to free in turn
+	std::vector<NodePtr> pending;
+	pending.push_back(std::move(subNode));
+	while (!pending.empty()) {
+		NodePtr node = std::move(pending.back());
+		pending.pop_back();
+		if (node != nullptr && node.use_count() == 1) {
+			// the last holder. see every write made before the others let go
+			std::atomic_thread_fence(std::memory_order_acquire);
+			std::vector<NodePtr>& children = const_cast<Node&>(*node).children_;
+			for (auto i = children.begin(); i != children.end(); ++i) {
+				pending.push_back(std::move(*i));
+			}
+			children.clear();
+		}
+	}
+}
+
+///////////////////////////////////////////////////////////////
+///////////// LiveTrie Implementation /////////////////////////
+///////////////////////////////////////////////////////////////
+
+LiveTrie::LiveTrie()
+	: current_{ std::make_shared<const PersistentTrie>() }
+{
+	// nothing to do here
+}
+
+PersistentTrie LiveTrie::snapshot() const
+{
+	// the loaded pointer keeps the version alive while it is copied
+	return *current();
+}
+
+void LiveTrie::publish(const PersistentTrie& version)
+{
+	std::lock_guard<std::mutex> lock(writer_);
+	replace(std::make_shared<const PersistentTrie>(version));
+}
+
+void LiveTrie::insert(const std::string& word)
+{
+	// readers keep using the old version until the swap
+	std::lock_guard<std::mutex> lock(writer_);
+	replace(std::make_shared<const PersistentTrie>(current()->insert(word)));
+}
+
+bool LiveTrie::remove(const std::string& word)
+{
+	std::lock_guard<std::mutex> lock(writer_);
+	std::shared_ptr<const PersistentTrie> version = current();
+	if (!version->exists(word)) {
+		return false;
+	}
+	replace(std::make_shared<const PersistentTrie>(version->remove(word)));
+	return true;
+}
+
+bool LiveTrie::exists(const std::string& word) const
+{
+	return current()->exists(word);
+}
+
+std::vector<std::string> LiveTrie::restOfString(const std::string& prefix) const
+{
+	return current()->restOfString(prefix);
+}
+
+std::shared_ptr<const PersistentTrie> LiveTrie::current() const
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+	return current_.load();
+#else
+	return std::atomic_load(&current_);
+#endif
+}
+
+void LiveTrie::replace(std::shared_ptr<const PersistentTrie> version)
+{
+#ifdef __cpp_lib_atomic_shared_ptr
+	current_.store(std::move(version));
+#else
+	std::atomic_store(&current_, std::move(version));
+#endif
+}
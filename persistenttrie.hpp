@@ -0,0 +1,281 @@
+/**
+* \file persistenttrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for PersistentTrie, a trie whose versions never change,
+*		 and LiveTrie, which publishes them to readers
+*
+*/
+
+// include gaurds
+#ifndef PERSISTENTTRIE_HPP_INCLUDED
+#define PERSISTENTTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <atomic>
+#if __has_include(<version>)
+#include <version> // __cpp_lib_atomic_shared_ptr
+#endif
+
+/// Immutable trie. insert and remove leave the trie alone and return a new
+///  version that shares every node off the path to the word. A version
+///  stays readable for as long as someone holds it, and a node is freed as
+///  soon as the last version that reaches it goes away
+class PersistentTrie {
+private:
+	struct Node;
+	typedef std::shared_ptr<const Node> NodePtr; // nodes never change once they are shared
+public:
+	/**
+	* \brief Default Constructor to create an empty trie
+	*/
+	PersistentTrie();
+
+	/**
+	* \brief			Copy Constructor. Shares every node of other
+	* \param  other		Version being copied
+	*/
+	PersistentTrie(const PersistentTrie& other);
+
+	/**
+	* \brief			Move Constructor. Leaves other empty
+	* \param  other		Version being moved
+	*/
+	PersistentTrie(PersistentTrie&& other) noexcept;
+
+	/**
+	* \brief			Assignment Operator. Shares every node of other
+	* \param  other		Version being copied
+	* \return			This trie
+	*/
+	PersistentTrie& operator=(const PersistentTrie& other);
+
+	/**
+	* \brief			Move Assignment Operator. Leaves other empty
+	* \param  other		Version being moved
+	* \return			This trie
+	*/
+	PersistentTrie& operator=(PersistentTrie&& other) noexcept;
+
+	/**
+	* \brief Destructor. Frees the nodes no other version holds with a
+	*		 loop, so a long chain of nodes does not go one call deeper
+	*		 per node
+	*/
+	~PersistentTrie();
+
+	/**
+	* \brief			Version with one more word
+	* \param  word	    Inserted word
+	* \return			New version. This one if word is empty or in the trie
+	*/
+	PersistentTrie insert(const std::string& word) const;
+
+	/**
+	* \brief			Version with one word less
+	* \param  word      Word being removed
+	* \return			New version. This one if word is not in the trie
+	* \note				Nodes left without words are dropped right away
+	*/
+	PersistentTrie remove(const std::string& word) const;
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(std::string word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	*/
+	std::vector<std::string> restOfString(std::string prefix) const;
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if Trie is empty
+	* \return			true if Trie is empty. false otherwise
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total mount of nodes in trie
+	* \note             Root Node does not count as node.
+	*					Expensive call because it searches all nodes
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with words in Trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by this version
+	* \return			Size of the trie object plus every node it reaches
+	* \note				Nodes shared with other versions are counted in each
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Position of the child of a node that holds a char
+	* \param  subNode	Node whose children are searched
+	*         c         Char being looked for
+	* \return           Where c is in the sorted keys, or where it would go
+	*/
+	static size_t findKey(const Node& subNode, char c);
+
+	/**
+	* \brief			Copies the path to a word and marks its end
+	* \param  subNode	Node the word goes below. null for a new node
+	*         word      Inserted word
+	* \return           Copy of subNode with the word below it
+	*/
+	static NodePtr insert(const NodePtr& subNode, const std::string& word);
+
+	/**
+	* \brief			Copies the path to a word and unmarks its end
+	* \param  subNode	Node the word is below. Must hold it
+	*         word      Removed word
+	* \return           Copy of subNode without the word. null if no word is
+	*					 left below it
+	*/
+	static NodePtr remove(const NodePtr& subNode, const std::string& word);
+
+	/**
+	* \brief			Adds every word below a node to output
+	* \param  subNode	Node whose words are collected
+	*         currWord  Word spelled by the path to subNode
+	*		  output    A vector that gets the words
+	*/
+	static void collectWords(const Node& subNode, std::string& currWord,
+		std::vector<std::string>& output);
+
+	/**
+	* \brief			Counts all the nodes below a node
+	* \param  subNode	Which node we are counting
+	* \return           Total amount of nodes below subNode
+	*/
+	static size_t countAllNodes(const Node& subNode);
+
+	/**
+	* \brief			Bytes of a node and every node below it
+	* \param  subNode	Node being measured
+	* \return           Bytes used
+	*/
+	static size_t nodeMemory(const Node& subNode);
+
+	/**
+	* \brief			Lets go of a node. Nodes nothing else holds give up
+	*					 their children first, so none of them frees a
+	*					 chain below it
+	* \param  subNode	Node being let go of. null afterwards
+	*/
+	static void release(NodePtr& subNode) noexcept;
+
+	/// NODE DECLARATION
+	struct Node {
+		bool endOfString_; // true if a word ends at this node. false otherwise
+		std::string keys_; // chars of the children. sorted as unsigned chars
+		std::vector<NodePtr> children_; // child of each key
+	};
+
+	/// private data members
+	NodePtr root_; // Root node. null while the trie is empty
+	size_t size_; // Amount of words contained in the trie
+};
+
+/// Holds the current PersistentTrie for many threads. Readers copy the
+///  pointer to the current version and read that version with no lock of
+///  the trie's own, so they never block on the writer mutex while a writer
+///  builds the next version. Writers take turns, and each one publishes its
+///  version by swapping the pointer. The pointer is a
+///  std::atomic<std::shared_ptr> where the library has one, and goes
+///  through std::atomic_load and std::atomic_store otherwise. Neither is
+///  lock-free in common libraries: the swap itself can take a short
+///  internal lock, but only for as long as a reference count update
+class LiveTrie {
+public:
+	/**
+	* \brief Default Constructor to create an empty trie
+	*/
+	LiveTrie();
+
+	/**
+	* \brief			Current version
+	* \return			Version that stays the same while it is read
+	*/
+	PersistentTrie snapshot() const;
+
+	/**
+	* \brief			Makes a version the current one
+	* \param  version	Next version
+	*/
+	void publish(const PersistentTrie& version);
+
+	/**
+	* \brief			Publishes the current version with one more word
+	* \param  word	    Inserted word
+	*/
+	void insert(const std::string& word);
+
+	/**
+	* \brief			Publishes the current version with one word less
+	* \param  word      Word being removed
+	* \return			true if word was in the trie. false otherwise
+	*/
+	bool remove(const std::string& word);
+
+	/**
+	* \brief			Check if a string exists in the current version
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(const std::string& word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string from the
+	*					 current version
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	*/
+	std::vector<std::string> restOfString(const std::string& prefix) const;
+private:
+	/**
+	* \brief			Loads the pointer to the current version
+	* \return			Pointer that keeps the version alive while it is held
+	*/
+	std::shared_ptr<const PersistentTrie> current() const;
+
+	/**
+	* \brief			Swaps in the pointer to the next version
+	* \param  version	Next version
+	*/
+	void replace(std::shared_ptr<const PersistentTrie> version);
+
+	/// private data members
+#ifdef __cpp_lib_atomic_shared_ptr
+	std::atomic<std::shared_ptr<const PersistentTrie> > current_; // Current version
+#else
+	std::shared_ptr<const PersistentTrie> current_; // Read and swapped only with atomic_load and atomic_store
+#endif
+	std::mutex writer_; // Held while a writer builds and publishes a version
+};
+
+#endif
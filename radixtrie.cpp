@@ -0,0 +1,382 @@
+/**
+* \file radixtrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for radixtrie.hpp
+*/
+#include "radixtrie.hpp"
+#include <stdexcept> // length_error
+
+///////////////////////////////////////////////////////////////
+///////////// RadixTrie Implementation ////////////////////////
+///////////////////////////////////////////////////////////////
+
+const RadixTrie::NodeIndex RadixTrie::ROOT;
+
+RadixTrie::RadixTrie()
+	: nodes_(1, Node()), edges_{ std::vector<Edge>() }, freeBlocks_{ EdgeBlock::FreeLists() },
+	labels_{ "" }, freeNodes_{ ROOT }, deadLabels_{ 0 }, size_{ 0 }, wordsRemoved_{ 0 }
+{
+	// nothing to do here
+}
+
+void RadixTrie::insert(std::string word)
+{
+	if (word.size() == 0) {
+		// empty word is never stored
+		return;
+	}
+
+	NodeIndex subNode = ROOT;
+	size_t pos = 0;
+	while (pos != word.size()) {
+		size_t found = findEdge(subNode, word[pos]);
+		if (found == edges_.size()) {
+			// no edge starts with this char. rest of word becomes a new edge
+			uint32_t label = addLabel(word, pos);
+			NodeIndex leaf = newNode();
+			nodes_[leaf].endOfString_ = true;
+			++size_;
+			addEdge(subNode, label, static_cast<uint32_t>(word.size() - pos), leaf);
+			return;
+		}
+
+		// see how much of the label matches the word
+		Edge edge = edges_[found];
+		uint32_t matched = 1; // first char matched by findEdge
+		while (matched != edge.length_ && pos + matched != word.size()
+			&& labels_[edge.label_ + matched] == word[pos + matched]) {
+			++matched;
+		}
+
+		if (matched != edge.length_) {
+			// word leaves the label halfway. split the edge with a middle node
+			//  that keeps the front of the label. first char does not change
+			//  so the block stays sorted
+			NodeIndex middle = newNode();
+			edges_[found].length_ = matched;
+			edges_[found].node_ = middle;
+			addEdge(middle, edge.label_ + matched, edge.length_ - matched, edge.node_);
+			edge.node_ = middle;
+		}
+
+		// move on past the label
+		subNode = edge.node_;
+		pos += matched;
+	}
+
+	// word ends at a node
+	if (!nodes_[subNode].endOfString_) {
+		nodes_[subNode].endOfString_ = true;
+		++size_;
+	}
+}
+
+bool RadixTrie::exists(std::string word) const
+{
+	// look for word in trie
+	NodeIndex found = findNode(word);
+	return (found != ROOT && nodes_[found].endOfString_);
+}
+
+std::vector<std::string> RadixTrie::restOfString(std::string prefix) const
+{
+	std::vector<std::string> output = std::vector<std::string>();
+
+	// finding our way to the end of the prefix
+	NodeIndex subNode = ROOT;
+	size_t pos = 0;
+	while (pos != prefix.size()) {
+		size_t found = findEdge(subNode, prefix[pos]);
+		if (found == edges_.size()) {
+			// character not in trie... no suggestions
+			return output;
+		}
+
+		const Edge& edge = edges_[found];
+		size_t left = prefix.size() - pos;
+		if (left < edge.length_) {
+			// prefix stops inside this label. every word below it is a suggestion
+			if (labels_.compare(edge.label_, left, prefix, pos, left) != 0) {
+				return output;
+			}
+			std::string word = prefix.substr(0, pos) + labels_.substr(edge.label_, edge.length_);
+			if (nodes_[edge.node_].endOfString_) {
+				output.push_back(word);
+			}
+			collectWords(edge.node_, word, output);
+			return output;
+		}
+
+		if (prefix.compare(pos, edge.length_, labels_, edge.label_, edge.length_) != 0) {
+			// prefix leaves the label... no suggestions
+			return output;
+		}
+		subNode = edge.node_;
+		pos += edge.length_;
+	}
+
+	// prefix ends at a node. keep searching sub nodes for words
+	collectWords(subNode, prefix, output);
+	return output;
+}
+
+bool RadixTrie::remove(std::string word)
+{
+	NodeIndex found = findNode(word);
+	if (found == ROOT || !nodes_[found].endOfString_) {
+		// didnt unmark end of word... return false
+		return false;
+	}
+
+	// umark as end of word. decrease size
+	nodes_[found].endOfString_ = false;
+	--size_;
+	++wordsRemoved_;
+
+	// check if we need to remove unused nodes
+	if (wordsRemoved_ == MAXWORDSREMOVED) {
+		removeUnusedNodes(ROOT);
+		wordsRemoved_ = 0;
+
+		// labels of dropped and merged edges stay behind until most of
+		//  labels_ is dead
+		if (deadLabels_ > labels_.size() / 2) {
+			compactLabels();
+		}
+	}
+	return true;
+}
+
+void RadixTrie::removeAll()
+{
+	nodes_ = std::vector<Node>(1, Node());
+	edges_ = std::vector<Edge>();
+	freeBlocks_ = EdgeBlock::FreeLists();
+	labels_ = std::string();
+	freeNodes_ = ROOT;
+	deadLabels_ = 0;
+	size_ = 0;
+	wordsRemoved_ = 0;
+}
+
+size_t RadixTrie::size() const
+{
+	return size_;
+}
+
+bool RadixTrie::empty() const
+{
+	return size_ == 0;
+}
+
+size_t RadixTrie::totalNodes() const
+{
+	return countAllNodes(ROOT);
+}
+
+std::ostream& RadixTrie::showStatistics(std::ostream& out) const
+{
+	out << "Words contained: " << size_;
+	out << ", Total nodes: " << totalNodes();
+	out << ", Words left till removing unused nodes: " << (MAXWORDSREMOVED - wordsRemoved_);
+	out << std::endl;
+	return out;
+}
+
+std::ostream& RadixTrie::print(std::ostream& out) const
+{
+	// find all the words inside the trie
+	std::vector<std::string> output = std::vector<std::string>();
+	collectWords(ROOT, "", output);
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		out << *i << ' ';
+	}
+	out << std::endl;
+	return out;
+}
+
+size_t RadixTrie::memoryUsage() const
+{
+	return sizeof(RadixTrie) + nodes_.capacity() * sizeof(Node)
+		+ edges_.capacity() * sizeof(Edge) + labels_.capacity();
+}
+
+size_t RadixTrie::findEdge(NodeIndex subNode, char c) const
+{
+	// edges are keyed by the first char of their label
+	const Node& node = nodes_[subNode];
+	return EdgeBlock::find(edges_, node.children_, node.childCount_, c, [this](const Edge& edge) {
+		return labels_[edge.label_];
+	});
+}
+
+void RadixTrie::addEdge(NodeIndex subNode, uint32_t label, uint32_t length, NodeIndex child)
+{
+	Node& node = nodes_[subNode];
+	EdgeBlock::insert(edges_, freeBlocks_, node.children_, node.childCount_, node.childCapacity_,
+		Edge{ label, length, child }, [this](const Edge& edge) {
+		return labels_[edge.label_];
+	});
+}
+
+RadixTrie::NodeIndex RadixTrie::newNode()
+{
+	if (freeNodes_ == ROOT) {
+		// no free nodes. grow the arena while indices stay below UINT32_MAX
+		if (nodes_.size() >= UINT32_MAX) {
+			throw std::length_error("RadixTrie has more nodes than a NodeIndex can address");
+		}
+		nodes_.push_back(Node());
+		return static_cast<NodeIndex>(nodes_.size() - 1);
+	}
+
+	// take the first free node
+	NodeIndex slot = freeNodes_;
+	freeNodes_ = nodes_[slot].children_;
+	nodes_[slot] = Node();
+	return slot;
+}
+
+void RadixTrie::freeNode(NodeIndex subNode)
+{
+	Node& node = nodes_[subNode];
+	EdgeBlock::release(freeBlocks_, node.children_, node.childCapacity_);
+	node = Node();
+	node.children_ = freeNodes_;
+	freeNodes_ = subNode;
+}
+
+uint32_t RadixTrie::addLabel(const std::string& chars, size_t pos)
+{
+	// labels and their lengths are 32-bit offsets
+	size_t label = labels_.size();
+	if (label + (chars.size() - pos) > UINT32_MAX) {
+		throw std::length_error("RadixTrie labels no longer fit in 32-bit offsets");
+	}
+	labels_.append(chars, pos, std::string::npos);
+	return static_cast<uint32_t>(label);
+}
+
+void RadixTrie::compactLabels()
+{
+	// copy the label of every edge still in the trie into a new arena
+	std::string labels;
+	labels.reserve(labels_.size() - deadLabels_);
+	std::vector<NodeIndex> pending(1, ROOT);
+	while (!pending.empty()) {
+		const Node& node = nodes_[pending.back()];
+		pending.pop_back();
+		for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+			Edge& edge = edges_[i];
+			uint32_t label = static_cast<uint32_t>(labels.size());
+			labels.append(labels_, edge.label_, edge.length_);
+			edge.label_ = label;
+			pending.push_back(edge.node_);
+		}
+	}
+	labels_.swap(labels);
+	deadLabels_ = 0;
+}
+
+RadixTrie::NodeIndex RadixTrie::findNode(const std::string& word) const
+{
+	NodeIndex subNode = ROOT;
+	size_t pos = 0;
+	while (pos != word.size()) {
+		size_t found = findEdge(subNode, word[pos]);
+		if (found == edges_.size()) {
+			// character not in trie
+			return ROOT;
+		}
+
+		// whole label has to match the word
+		const Edge& edge = edges_[found];
+		if (word.size() - pos < edge.length_
+			|| word.compare(pos, edge.length_, labels_, edge.label_, edge.length_) != 0) {
+			return ROOT;
+		}
+		subNode = edge.node_;
+		pos += edge.length_;
+	}
+	return subNode;
+}
+
+void RadixTrie::collectWords(NodeIndex subNode, const std::string& currWord,
+	std::vector<std::string>& output) const
+{
+	const Node& node = nodes_[subNode];
+	for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+		const Edge& edge = edges_[i];
+		std::string word = currWord + labels_.substr(edge.label_, edge.length_);
+		if (nodes_[edge.node_].endOfString_) {
+			// add word to output
+			output.push_back(word);
+		}
+		collectWords(edge.node_, word, output);
+	}
+}
+
+bool RadixTrie::removeUnusedNodes(NodeIndex subNode)
+{
+	const Node& node = nodes_[subNode];
+	size_t first = node.children_;
+	size_t last = first + node.childCount_;
+	size_t kept = first;
+	for (size_t i = first; i != last; ++i) {
+		// search to see if we need to remove child
+		Edge edge = edges_[i];
+		bool keepSubNode = removeUnusedNodes(edge.node_);
+		const Node& child = nodes_[edge.node_];
+		if (!child.endOfString_ && !keepSubNode) {
+			// no word ends at or below child. drop the edge and free child
+			deadLabels_ += edge.length_;
+			freeNode(edge.node_);
+			continue;
+		}
+
+		if (!child.endOfString_ && child.childCount_ == 1) {
+			// child only passes through to one grandchild. merge both labels
+			//  into one edge. labels that came from a split are already
+			//  next to each other in labels_
+			Edge next = edges_[child.children_];
+			if (edge.label_ + edge.length_ != next.label_) {
+				std::string merged = labels_.substr(edge.label_, edge.length_)
+					+ labels_.substr(next.label_, next.length_);
+				deadLabels_ += merged.size();
+				edge.label_ = addLabel(merged, 0);
+			}
+			freeNode(edge.node_);
+			edge.length_ += next.length_;
+			edge.node_ = next.node_;
+		}
+		edges_[kept] = edge;
+		++kept;
+	}
+	nodes_[subNode].childCount_ = static_cast<uint16_t>(kept - first);
+
+	// return whether we should keep nodes or not
+	return kept != first;
+}
+
+size_t RadixTrie::countAllNodes(NodeIndex subNode) const
+{
+	size_t count = 0;
+	const Node& node = nodes_[subNode];
+	for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+		// child is a node plus all of its own nodes
+		count += 1 + countAllNodes(edges_[i].node_);
+	}
+	return count;
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Node Implementation /////////////////////////////
+///////////////////////////////////////////////////////////////
+
+RadixTrie::Node::Node()
+	: endOfString_{ false }, childCount_{ 0 }, childCapacity_{ 0 }, children_{ 0 }
+{
+	// nothing to do here
+}
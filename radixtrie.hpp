@@ -0,0 +1,228 @@
+/**
+* \file radixtrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for RadixTrie, a path-compressed Trie
+*
+*/
+
+// include gaurds
+#ifndef RADIXTRIE_HPP_INCLUDED
+#define RADIXTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include "trie.hpp" // MAXWORDSREMOVED
+#include "edgeblock.hpp"
+
+/// Trie where chains of nodes with a single child are collapsed into
+///  one edge labeled with the whole chain. Same operations as Trie
+class RadixTrie {
+private:
+	struct Node;
+	struct Edge;
+	typedef uint32_t NodeIndex; // position of a node inside nodes_
+public:
+	/**
+	* \brief Default Constructor to create an empty trie
+	*/
+	RadixTrie();
+
+	/**
+	* \brief			Insert a string into the trie
+	* \param  word	    Inserted word
+	* \note				Splits an edge when word leaves it halfway
+	* \throws			std::length_error if the nodes, edges or labels no
+	*					 longer fit in 32-bit offsets
+	*/
+	void insert(std::string word);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(std::string word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	*/
+	std::vector<std::string> restOfString(std::string prefix) const;
+
+	/**
+	* \brief			Remove a string from the trie
+	* \param  word      Word being removed
+	* \return			true if word is removed from trie. false otherwise
+	*/
+	bool remove(std::string word);
+
+	/**
+	* \brief			Remove all strings from trie
+	*/
+	void removeAll();
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if Trie is empty
+	* \return			true if Trie is empty. false otherwise
+	* \note				Trie can be empty but still have nodes.
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total mount of nodes in trie
+	* \note             Root Node does not count as node.
+	*					Expensive call because it searches all nodes
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out Statistics of the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with statistics
+	* \note				Contains endl at end
+	*/
+	std::ostream& showStatistics(std::ostream& out) const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with words in Trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the trie object plus its arenas
+	* \note				Counts reserved capacity, not only the nodes in use
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Finds the edge of a node that starts with a char
+	* \param  subNode	Node whose edges are searched
+	*         c         First char of the edge label
+	* \return           Offset of the edge in edges_. edges_.size() if none
+	*/
+	size_t findEdge(NodeIndex subNode, char c) const;
+
+	/**
+	* \brief			Adds an edge to a node keeping the edges sorted
+	* \param  subNode	Node that gets the new edge
+	*         label     Offset of the edge label in labels_
+	*         length    Length of the edge label
+	*         child     Node the edge leads to
+	*/
+	void addEdge(NodeIndex subNode, uint32_t label, uint32_t length, NodeIndex child);
+
+	/**
+	* \brief			Gives out a node, a free one if there is one
+	* \return           Index of the node
+	* \throws			std::length_error if nodes_ would outgrow a NodeIndex
+	*/
+	NodeIndex newNode();
+
+	/**
+	* \brief			Puts a node that no edge leads to on the free list
+	*					 and gives its edge block back
+	* \param  subNode	Node being freed
+	*/
+	void freeNode(NodeIndex subNode);
+
+	/**
+	* \brief			Adds the end of a string to labels_
+	* \param  chars	    String holding the label
+	*         pos       Where the label starts in chars
+	* \return           Offset of the label in labels_
+	* \throws			std::length_error if labels_ would outgrow 32-bit offsets
+	*/
+	uint32_t addLabel(const std::string& chars, size_t pos);
+
+	/**
+	* \brief			Rebuilds labels_ with only the labels edges use
+	*/
+	void compactLabels();
+
+	/**
+	* \brief			Walks down the trie along a word
+	* \param  word	    Word being followed
+	* \return           Node reached after the whole word. ROOT if the word
+	*					 runs out of edges or stops halfway through one
+	*/
+	NodeIndex findNode(const std::string& word) const;
+
+	/**
+	* \brief			Adds every word below a node to output
+	* \param  subNode	Node whose words are collected
+	*         currWord  Word spelled by the path to subNode
+	*		  output    A vector that gets the words
+	*/
+	void collectWords(NodeIndex subNode, const std::string& currWord,
+		std::vector<std::string>& output) const;
+
+	/**
+	* \brief			Remove Nodes that are not part of words and merge
+	*					 nodes left with a single child into their parent edge
+	* \param  subNode	Which node we are looking for unused words
+	* \return           true if we should keep the subNode
+	*/
+	bool removeUnusedNodes(NodeIndex subNode);
+
+	/**
+	* \brief			Counts all the nodes being used
+	* \param  subNode	Which node we are counting
+	* \return           Total amount of nodes below subNode
+	*/
+	size_t countAllNodes(NodeIndex subNode) const;
+
+	/// NODE DECLARATION
+	struct Node {
+	public:
+		/**
+		* \brief Default Constructor
+		*/
+		Node();
+
+	private:
+		friend class RadixTrie; // RadixTrie can see private data members
+
+		bool endOfString_; // true if a node represents end of string. false otherwise
+		uint16_t childCount_; // amount of edges in use
+		uint16_t childCapacity_; // amount of edges reserved
+		uint32_t children_; // offset in edges_ of the first edge
+	};
+
+	/// EDGE DECLARATION
+	struct Edge {
+		uint32_t label_; // offset of the label in labels_
+		uint32_t length_; // length of the label. Never 0
+		NodeIndex node_; // node at the end of the label
+	};
+
+	/// Index of the root node. Also used to mean "no node"
+	static const NodeIndex ROOT = 0;
+
+	/// private data members
+	std::vector<Node> nodes_; // Node arena. nodes_[ROOT] is the root node
+	std::vector<Edge> edges_; // Edge arena. Each node owns a block sorted by first char
+	EdgeBlock::FreeLists freeBlocks_; // Blocks of edges_ no node uses
+	std::string labels_; // Label arena. Split edges share the label they came from
+	NodeIndex freeNodes_; // First free node. Free nodes link through children_. ROOT ends the list
+	size_t deadLabels_; // Bytes of labels_ no edge uses
+	size_t size_; // Amount of words contained in the trie
+	size_t wordsRemoved_; // Amount of words that have been removed
+};
+
+#endif
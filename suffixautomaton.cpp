@@ -0,0 +1,241 @@
+/**
+* \file suffixautomaton.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for suffixautomaton.hpp
+*/
+#include "suffixautomaton.hpp"
+#include <algorithm> // reverse
+#include <stdexcept> // length_error
+
+///////////////////////////////////////////////////////////////
+///////////// SuffixAutomaton Implementation //////////////////
+///////////////////////////////////////////////////////////////
+
+const SuffixAutomaton::StateIndex SuffixAutomaton::START;
+const SuffixAutomaton::StateIndex SuffixAutomaton::NOSTATE;
+const uint32_t SuffixAutomaton::NOWORD;
+
+SuffixAutomaton::SuffixAutomaton()
+	: trie_{ Trie() }, states_(1, State(0)), wordStarts_(1, 0)
+{
+	// nothing to do here
+}
+
+void SuffixAutomaton::insert(std::string word)
+{
+	if (word.size() == 0 || trie_.exists(word)) {
+		// nothing new to find
+		return;
+	}
+	if (text_.size() + word.size() > NOWORD) {
+		throw std::length_error("SuffixAutomaton words no longer fit in 32-bit offsets");
+	}
+	trie_.insert(word);
+
+	// add the word one char at a time from the start state. each step
+	//  ends at the state of a prefix of the word
+	std::vector<StateIndex> prefixes;
+	prefixes.reserve(word.size());
+	StateIndex last = START;
+	for (auto i = word.begin(); i != word.end(); ++i) {
+		last = extend(last, *i);
+		prefixes.push_back(last);
+	}
+
+	// every substring is a suffix of a prefix. walk the suffix links of
+	//  each prefix and add the word to the states that do not have it yet
+	uint32_t id = static_cast<uint32_t>(wordStarts_.size() - 1);
+	for (auto i = prefixes.begin(); i != prefixes.end(); ++i) {
+		for (StateIndex state = *i; state != START && states_[state].lastWord_ != id; state = states_[state].link_) {
+			Occurrence occurrence = { id, states_[state].words_ };
+			states_[state].words_ = static_cast<uint32_t>(occurrences_.size());
+			states_[state].lastWord_ = id;
+			occurrences_.push_back(occurrence);
+		}
+	}
+
+	text_ += word;
+	wordStarts_.push_back(static_cast<uint32_t>(text_.size()));
+}
+
+bool SuffixAutomaton::exists(std::string word) const
+{
+	return trie_.exists(word);
+}
+
+std::vector<std::string> SuffixAutomaton::restOfString(std::string prefix) const
+{
+	return trie_.restOfString(prefix);
+}
+
+std::vector<std::string> SuffixAutomaton::containing(const std::string& substring) const
+{
+	std::vector<std::string> output;
+	if (substring.size() == 0) {
+		// every word contains the empty string
+		for (size_t i = 0; i + 1 != wordStarts_.size(); ++i) {
+			output.push_back(text_.substr(wordStarts_[i], wordStarts_[i + 1] - wordStarts_[i]));
+		}
+		return output;
+	}
+
+	// follow the substring from the start state
+	StateIndex state = START;
+	for (auto i = substring.begin(); i != substring.end(); ++i) {
+		state = findEdge(state, *i);
+		if (state == NOSTATE) {
+			// not a substring of any word
+			return output;
+		}
+	}
+
+	// newest word is first in the list
+	for (uint32_t i = states_[state].words_; i != NOWORD; i = occurrences_[i].next_) {
+		uint32_t word = occurrences_[i].word_;
+		output.push_back(text_.substr(wordStarts_[word], wordStarts_[word + 1] - wordStarts_[word]));
+	}
+	std::reverse(output.begin(), output.end());
+	return output;
+}
+
+size_t SuffixAutomaton::size() const
+{
+	return trie_.size();
+}
+
+bool SuffixAutomaton::empty() const
+{
+	return trie_.empty();
+}
+
+size_t SuffixAutomaton::totalStates() const
+{
+	return states_.size();
+}
+
+size_t SuffixAutomaton::memoryUsage() const
+{
+	return sizeof(SuffixAutomaton) - sizeof(Trie) + trie_.memoryUsage()
+		+ states_.capacity() * sizeof(State) + edges_.capacity() * sizeof(Edge)
+		+ occurrences_.capacity() * sizeof(Occurrence) + text_.capacity()
+		+ wordStarts_.capacity() * sizeof(uint32_t);
+}
+
+SuffixAutomaton::StateIndex SuffixAutomaton::extend(StateIndex last, char c)
+{
+	StateIndex next = findEdge(last, c);
+	if (next != NOSTATE) {
+		// another word already went this way
+		if (states_[next].length_ == states_[last].length_ + 1) {
+			return next;
+		}
+
+		// next also holds longer strings that do not end here. split
+		//  off the short ones
+		StateIndex clone = cloneState(next, states_[last].length_ + 1);
+		states_[next].link_ = clone;
+		for (StateIndex p = last; p != NOSTATE && findEdge(p, c) == next; p = states_[p].link_) {
+			setEdge(p, c, clone);
+		}
+		return clone;
+	}
+
+	// new longest string. every suffix without an edge for c gets one
+	StateIndex current = newState(states_[last].length_ + 1);
+	StateIndex p = last;
+	while (p != NOSTATE && findEdge(p, c) == NOSTATE) {
+		setEdge(p, c, current);
+		p = states_[p].link_;
+	}
+
+	if (p == NOSTATE) {
+		// only the empty string is a shorter suffix
+		states_[current].link_ = START;
+		return current;
+	}
+
+	StateIndex q = findEdge(p, c);
+	if (states_[q].length_ == states_[p].length_ + 1) {
+		states_[current].link_ = q;
+		return current;
+	}
+
+	// q holds longer strings too. split off the short ones
+	StateIndex clone = cloneState(q, states_[p].length_ + 1);
+	for (; p != NOSTATE && findEdge(p, c) == q; p = states_[p].link_) {
+		setEdge(p, c, clone);
+	}
+	states_[q].link_ = clone;
+	states_[current].link_ = clone;
+	return current;
+}
+
+SuffixAutomaton::StateIndex SuffixAutomaton::cloneState(StateIndex state, uint32_t length)
+{
+	StateIndex clone = newState(length);
+	State copy = states_[state];
+	copy.length_ = length;
+
+	// own copy of the edges
+	EdgeBlock::copy(edges_, freeBlocks_, copy.edges_, copy.edgeCount_, copy.edges_, copy.edgeCapacity_);
+
+	// the shorter strings are in every word the longer ones are in
+	copy.words_ = NOWORD;
+	uint32_t tail = NOWORD;
+	for (uint32_t i = states_[state].words_; i != NOWORD; i = occurrences_[i].next_) {
+		uint32_t at = static_cast<uint32_t>(occurrences_.size());
+		Occurrence occurrence = { occurrences_[i].word_, NOWORD };
+		occurrences_.push_back(occurrence);
+		if (tail == NOWORD) {
+			copy.words_ = at;
+		}
+		else {
+			occurrences_[tail].next_ = at;
+		}
+		tail = at;
+	}
+
+	states_[clone] = copy;
+	return clone;
+}
+
+SuffixAutomaton::StateIndex SuffixAutomaton::newState(uint32_t length)
+{
+	if (states_.size() >= NOSTATE) {
+		throw std::length_error("SuffixAutomaton has more states than a StateIndex can address");
+	}
+	states_.push_back(State(length));
+	return static_cast<StateIndex>(states_.size() - 1);
+}
+
+SuffixAutomaton::StateIndex SuffixAutomaton::findEdge(StateIndex state, char c) const
+{
+	const State& node = states_[state];
+	size_t found = EdgeBlock::find(edges_, node.edges_, node.edgeCount_, c);
+	return (found != edges_.size()) ? edges_[found].state_ : NOSTATE;
+}
+
+void SuffixAutomaton::setEdge(StateIndex state, char c, StateIndex target)
+{
+	State& node = states_[state];
+	size_t found = EdgeBlock::find(edges_, node.edges_, node.edgeCount_, c);
+	if (found != edges_.size()) {
+		// edge is there. point it at target
+		edges_[found].state_ = target;
+		return;
+	}
+	EdgeBlock::insert(edges_, freeBlocks_, node.edges_, node.edgeCount_, node.edgeCapacity_, Edge{ c, target });
+}
+
+///////////////////////////////////////////////////////////////
+///////////// State Implementation ////////////////////////////
+///////////////////////////////////////////////////////////////
+
+SuffixAutomaton::State::State(uint32_t length)
+	: length_{ length }, link_{ NOSTATE }, lastWord_{ NOWORD }, words_{ NOWORD },
+	edgeCount_{ 0 }, edgeCapacity_{ 0 }, edges_{ 0 }
+{
+	// nothing to do here
+}
@@ -0,0 +1,187 @@
+/**
+* \file suffixautomaton.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for SuffixAutomaton, a trie of words that can also find
+*		 the words that contain a substring
+*
+*/
+
+// include gaurds
+#ifndef SUFFIXAUTOMATON_HPP_INCLUDED
+#define SUFFIXAUTOMATON_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include <cstdint>
+#include "trie.hpp"
+#include "edgeblock.hpp"
+
+/// Words in a Trie plus a generalized suffix automaton over all of them.
+///  The automaton is the smallest automaton that accepts every substring
+///  of every word: each state stands for a set of substrings that end in
+///  the same places, and keeps the list of words that contain them. Words
+///  are added one at a time and can not be removed
+class SuffixAutomaton {
+private:
+	struct State;
+	struct Edge;
+	struct Occurrence;
+	typedef uint32_t StateIndex; // position of a state inside states_
+public:
+	/**
+	* \brief Default Constructor to create an empty automaton
+	*/
+	SuffixAutomaton();
+
+	/**
+	* \brief			Insert a string into the trie and the automaton
+	* \param  word	    Inserted word
+	* \throws			std::length_error if the states or edges no longer
+	*					 fit in 32-bit indices
+	*/
+	void insert(std::string word);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(std::string word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	*/
+	std::vector<std::string> restOfString(std::string prefix) const;
+
+	/**
+	* \brief			Finds the words that contain a string anywhere
+	* \param  substring String being searched
+	* \return			Words that contain substring, in the order they were
+	*					 inserted. Every word if substring is empty
+	* \note				O(m + k) for a substring of length m and k words
+	*/
+	std::vector<std::string> containing(const std::string& substring) const;
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if Trie is empty
+	* \return			true if Trie is empty. false otherwise
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Amount of states in the automaton
+	* \return			States, the start state included
+	*/
+	size_t totalStates() const;
+
+	/**
+	* \brief			Bytes used by the trie and the automaton
+	* \return			Size of the object plus its trie and arenas
+	* \note				Counts reserved capacity, not only what is in use
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Adds a char after the strings of a state
+	* \param  last		State of the prefix of the word so far
+	*         c         Char being added
+	* \return           State of the prefix with c
+	*/
+	StateIndex extend(StateIndex last, char c);
+
+	/**
+	* \brief			Copies a state, with its edges and words, for the
+	*					 shorter strings of the state
+	* \param  state		State being split
+	*         length    Longest string of the copy
+	* \return           Index of the copy
+	*/
+	StateIndex cloneState(StateIndex state, uint32_t length);
+
+	/**
+	* \brief			Creates a state without edges or words
+	* \param  length	Longest string of the state
+	* \return           Index of the new state
+	*/
+	StateIndex newState(uint32_t length);
+
+	/**
+	* \brief			Looks for the edge of a state that holds a char
+	* \param  state		State whose edges are searched
+	*         c         Char being looked for
+	* \return           State the edge leads to. NOSTATE if there is no such edge
+	*/
+	StateIndex findEdge(StateIndex state, char c) const;
+
+	/**
+	* \brief			Adds an edge or points an edge somewhere else
+	* \param  state		State that gets the edge
+	*         c         Char of the edge
+	*         target    State the edge leads to
+	*/
+	void setEdge(StateIndex state, char c, StateIndex target);
+
+	/// STATE DECLARATION
+	struct State {
+	public:
+		/**
+		* \brief			Constructor
+		* \param  length	Longest string of the state
+		*/
+		explicit State(uint32_t length);
+
+	private:
+		friend class SuffixAutomaton; // SuffixAutomaton can see private data members
+
+		uint32_t length_; // length of the longest string of the state
+		StateIndex link_; // state of the longest suffix that ends in more places
+		uint32_t lastWord_; // last word added to words_. NOWORD if none
+		uint32_t words_; // first occurrence in occurrences_. NOWORD ends the list
+		uint16_t edgeCount_; // amount of edges in use
+		uint16_t edgeCapacity_; // amount of edges reserved
+		uint32_t edges_; // offset in edges_ of the first edge
+	};
+
+	/// EDGE DECLARATION
+	struct Edge {
+		char key_; // char of the edge
+		StateIndex state_; // state the edge leads to
+	};
+
+	/// OCCURRENCE DECLARATION
+	struct Occurrence {
+		uint32_t word_; // word that contains the strings of a state
+		uint32_t next_; // next occurrence of the state. NOWORD ends the list
+	};
+
+	/// Index of the start state, the state of the empty string
+	static const StateIndex START = 0;
+
+	/// Ends suffix links and marks a missing edge
+	static const StateIndex NOSTATE = UINT32_MAX;
+
+	/// Ends occurrence lists and marks a state without words
+	static const uint32_t NOWORD = UINT32_MAX;
+
+	/// private data members
+	Trie trie_; // The words, for exists and restOfString
+	std::vector<State> states_; // State arena. states_[START] is the start state
+	std::vector<Edge> edges_; // Edge arena. Each state owns a block sorted by key_
+	EdgeBlock::FreeLists freeBlocks_; // Blocks of edges_ no state uses
+	std::vector<Occurrence> occurrences_; // Word lists of the states
+	std::string text_; // Chars of every word, one after another
+	std::vector<uint32_t> wordStarts_; // Where each word starts in text_, plus where the next would
+};
+
+#endif
@@ -2,7 +2,31 @@
 #include "catch.hpp"
 
 #include <fstream> //ifstream
+#include <algorithm> //sort
+#include <stdexcept> //invalid_argument
+#include <thread> //thread
+#include <atomic> //atomic
+#include <sstream> //ostringstream
+#include <iterator>
+#include <type_traits> //back_inserter, ostream_iterator
+#if __has_include(<version>)
+#include <version> //__cpp_lib_ranges
+#endif
+#ifdef __cpp_lib_ranges
+#include <ranges> //views::take
+#endif
 #include "trie.hpp"
+#include "radixtrie.hpp"
+#include "frozentrie.hpp"
+#include "loudstrie.hpp"
+#include "dawg.hpp"
+#include "bursttrie.hpp"
+#include "hattrie.hpp"
+#include "persistenttrie.hpp"
+#include "triemap.hpp"
+#include "suffixautomaton.hpp"
+#include "twowaytrie.hpp"
+#include "edgeblock.hpp"
 using namespace std;
 
 TEST_CASE("Testing Default Constructor")
@@ -202,3 +226,1696 @@ TEST_CASE("HUGE DICTIONARY")
 	REQUIRE(testingTrie.empty());
 	testingTrie.showStatistics(cout);
 }
+
+
+TEST_CASE("Testing Rest of Word Order")
+{
+	// children are kept sorted so words come out in order
+	Trie testingTrie = Trie();
+	testingTrie.insert("you");
+	testingTrie.insert("abc");
+	testingTrie.insert("yours");
+	testingTrie.insert("ab");
+	testingTrie.insert("your");
+
+	vector<string> expected = { "ab", "abc", "you", "your", "yours" };
+	REQUIRE(testingTrie.restOfString("") == expected);
+
+	expected = { "your", "yours" };
+	REQUIRE(testingTrie.restOfString("you") == expected);
+	REQUIRE(testingTrie.restOfString("z").empty());
+}
+
+
+TEST_CASE("Testing RadixTrie")
+{
+	RadixTrie testingTrie = RadixTrie();
+
+	// one word is a single edge
+	testingTrie.insert("hello");
+	REQUIRE(testingTrie.exists("hello"));
+	REQUIRE(!testingTrie.exists("hell"));
+	REQUIRE(!testingTrie.exists("helloo"));
+	REQUIRE(testingTrie.totalNodes() == 1);
+
+	// splitting the edge adds a middle node
+	testingTrie.insert("help");
+	REQUIRE(testingTrie.totalNodes() == 3);
+	testingTrie.insert("hel");
+	REQUIRE(testingTrie.totalNodes() == 3);
+	REQUIRE(testingTrie.exists("hel"));
+	REQUIRE(testingTrie.size() == 3);
+
+	// prefixes that stop inside an edge
+	vector<string> expected = { "hel", "hello", "help" };
+	REQUIRE(testingTrie.restOfString("he") == expected);
+	expected = { "hello", "help" };
+	REQUIRE(testingTrie.restOfString("hel") == expected);
+	expected = { "hello" };
+	REQUIRE(testingTrie.restOfString("hell") == expected);
+	REQUIRE(testingTrie.restOfString("hex").empty());
+
+	// middle node is merged away once unused nodes are removed
+	REQUIRE(testingTrie.remove("hel"));
+	REQUIRE(!testingTrie.remove("hel"));
+	REQUIRE(testingTrie.remove("help"));
+	for (size_t i = 2; i != MAXWORDSREMOVED; ++i) {
+		testingTrie.insert("x");
+		REQUIRE(testingTrie.remove("x"));
+	}
+	REQUIRE(testingTrie.totalNodes() == 1);
+	REQUIRE(testingTrie.exists("hello"));
+	REQUIRE(!testingTrie.exists("hel"));
+}
+
+
+TEST_CASE("RadixTrie HUGE DICTIONARY")
+{
+	// radix trie should hold the same words as the trie with fewer nodes
+	Trie trie = Trie();
+	RadixTrie radix = RadixTrie();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		trie.insert(line);
+		radix.insert(line);
+		words.push_back(line);
+	}
+	REQUIRE(radix.size() == trie.size());
+	REQUIRE(radix.totalNodes() < trie.totalNodes());
+	REQUIRE(radix.restOfString("") == trie.restOfString(""));
+	REQUIRE(radix.restOfString("th") == trie.restOfString("th"));
+	radix.showStatistics(cout);
+
+	// remove every other word
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(radix.remove(words[i]));
+		REQUIRE(trie.remove(words[i]));
+	}
+	for (size_t i = 0; i != words.size(); ++i) {
+		REQUIRE(radix.exists(words[i]) == (i % 2 == 1));
+	}
+	REQUIRE(radix.restOfString("") == trie.restOfString(""));
+	REQUIRE(radix.restOfString("co") == trie.restOfString("co"));
+
+	// removing and inserting every word again reuses nodes, edge blocks
+	//  and label bytes
+	for (size_t i = 1; i < words.size(); i += 2) {
+		REQUIRE(radix.remove(words[i]));
+	}
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		radix.insert(*i);
+	}
+	size_t memory = radix.memoryUsage();
+	for (size_t round = 0; round != 10; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			REQUIRE(radix.remove(*i));
+		}
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			radix.insert(*i);
+		}
+	}
+	REQUIRE(radix.memoryUsage() < memory * 2);
+	REQUIRE(radix.size() == words.size());
+	REQUIRE(radix.exists(words[0]));
+	REQUIRE(radix.restOfString("co").size() > trie.restOfString("co").size());
+}
+
+
+TEST_CASE("Testing Wide Nodes")
+{
+	// root grows through every kind of child block
+	Trie testingTrie = Trie();
+	vector<string> words;
+	for (int c = 0; c != 256; ++c) {
+		string word = string(1, static_cast<char>(c)) + "x";
+		testingTrie.insert(word);
+		words.push_back(word);
+		REQUIRE(testingTrie.exists(word));
+		REQUIRE(testingTrie.totalNodes() == 2 * words.size());
+	}
+	sort(words.begin(), words.end());
+	REQUIRE(testingTrie.restOfString("") == words);
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(testingTrie.exists(*i));
+		REQUIRE(!testingTrie.exists(i->substr(0, 1)));
+	}
+
+	// removing words shrinks the root back down
+	vector<string> left;
+	size_t removed = 0;
+	for (size_t i = 0; i != words.size(); ++i) {
+		if (i % 40 == 0) {
+			left.push_back(words[i]);
+		}
+		else {
+			REQUIRE(testingTrie.remove(words[i]));
+			++removed;
+		}
+	}
+
+	// keep removing until unused nodes get removed
+	while (removed % MAXWORDSREMOVED != 0) {
+		testingTrie.insert("y");
+		REQUIRE(testingTrie.remove("y"));
+		++removed;
+	}
+	REQUIRE(testingTrie.totalNodes() == 2 * left.size());
+	REQUIRE(testingTrie.restOfString("") == left);
+	for (auto i = left.begin(); i != left.end(); ++i) {
+		REQUIRE(testingTrie.exists(*i));
+	}
+}
+
+
+TEST_CASE("Testing Bitmap Nodes")
+{
+	// children arrive out of order, so the dense array has to open up
+	//  slots in the middle. 40 children keeps the root a bitmap node
+	Trie testingTrie = Trie();
+	vector<string> words;
+	for (int i = 0; i != 40; ++i) {
+		int c = (i * 97 + 13) % 256;
+		words.push_back(string(1, static_cast<char>(c)) + "z");
+		testingTrie.insert(words.back());
+		REQUIRE(testingTrie.exists(words.back()));
+	}
+	sort(words.begin(), words.end());
+	REQUIRE(testingTrie.restOfString("") == words);
+	for (int c = 0; c != 256; ++c) {
+		string word = string(1, static_cast<char>(c)) + "z";
+		REQUIRE(testingTrie.exists(word) == binary_search(words.begin(), words.end(), word));
+	}
+}
+
+
+TEST_CASE("Testing Inline Children")
+{
+	// a chain keeps its children inside the nodes. no child blocks
+	Trie testingTrie = Trie();
+	testingTrie.insert("abcdefghijklmnop");
+	size_t chainMemory = testingTrie.memoryUsage();
+	REQUIRE(testingTrie.exists("abcdefghijklmnop"));
+
+	// one more child than fits inline spills into a block
+	vector<string> words;
+	for (size_t i = 0; i != INLINECHILDREN + 1; ++i) {
+		words.push_back(string("abc") + static_cast<char>('z' - i));
+		testingTrie.insert(words.back());
+	}
+	REQUIRE(testingTrie.memoryUsage() > chainMemory);
+	vector<string> expected = words;
+	expected.push_back("abcdefghijklmnop");
+	sort(expected.begin(), expected.end());
+	REQUIRE(testingTrie.restOfString("abc") == expected);
+
+	// removing them moves the rest back inside the node
+	size_t removed = 0;
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(testingTrie.remove(*i));
+		++removed;
+	}
+	while (removed % MAXWORDSREMOVED != 0) {
+		testingTrie.insert("q");
+		REQUIRE(testingTrie.remove("q"));
+		++removed;
+	}
+	REQUIRE(testingTrie.totalNodes() == 16);
+	REQUIRE(testingTrie.exists("abcdefghijklmnop"));
+	expected = { "abcdefghijklmnop" };
+	REQUIRE(testingTrie.restOfString("abc") == expected);
+}
+
+
+TEST_CASE("Testing Alphabets")
+{
+	// lowercase trie takes lowercase words only
+	BasicTrie<LowerAsciiAlphabet> letters = BasicTrie<LowerAsciiAlphabet>();
+	vector<string> words = { "zebra", "apple", "mango", "app", "applied" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		letters.insert(*i);
+	}
+	REQUIRE_THROWS_AS(letters.insert("Apple"), std::invalid_argument);
+	REQUIRE_THROWS_AS(letters.insert("app1e"), std::invalid_argument);
+	REQUIRE(letters.size() == 5);
+	REQUIRE(!letters.exists("Apple"));
+	REQUIRE(!letters.exists("app1e"));
+	REQUIRE(letters.restOfString("A").empty());
+	vector<string> expected = { "apple", "applied" };
+	REQUIRE(letters.restOfString("app") == expected);
+
+	// every letter under one node. it ends up as a direct array
+	for (char c = 'z'; c >= 'a'; --c) {
+		letters.insert(string("q") + c);
+	}
+	for (char c = 'a'; c <= 'z'; ++c) {
+		REQUIRE(letters.exists(string("q") + c));
+	}
+	REQUIRE(letters.restOfString("q").size() == 26);
+	REQUIRE(letters.restOfString("q").front() == "qa");
+	expected = { "app", "apple", "applied", "mango", "qa" };
+	vector<string> all = letters.restOfString("");
+	REQUIRE(vector<string>(all.begin(), all.begin() + 5) == expected);
+	REQUIRE(all.back() == "zebra");
+
+	// digit trie grows straight from 4 children to 10 slots
+	BasicTrie<DigitAlphabet> digits = BasicTrie<DigitAlphabet>();
+	for (int i = 0; i < 1000; i += 7) {
+		digits.insert(to_string(i));
+	}
+	for (int i = 0; i != 1000; ++i) {
+		REQUIRE(digits.exists(to_string(i)) == (i % 7 == 0));
+	}
+	REQUIRE(!digits.exists("x"));
+	for (int i = 0; i < 1000; i += 14) {
+		REQUIRE(digits.remove(to_string(i)));
+	}
+	for (int i = 0; i != 1000; ++i) {
+		REQUIRE(digits.exists(to_string(i)) == (i % 7 == 0 && i % 14 != 0));
+	}
+	vector<string> found = digits.restOfString("");
+	REQUIRE(std::is_sorted(found.begin(), found.end()));
+	REQUIRE(found.size() == digits.size());
+}
+
+
+TEST_CASE("Testing Nibble Alphabet")
+{
+	// binary and UTF-8 keys go in two levels per byte
+	BasicTrie<NibbleAlphabet> nibbles = BasicTrie<NibbleAlphabet>();
+	Trie bytes = Trie();
+	vector<string> words = { string("\0\1", 2), string("\xff\xfe", 2), "\xc3\xa9t\xc3\xa9",
+		"\xc3\xa9", "caf\xc3\xa9", "cafe", "caf", string(1, '\0'), "\x7f" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		nibbles.insert(*i);
+		bytes.insert(*i);
+	}
+	REQUIRE(nibbles.size() == words.size());
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(nibbles.exists(*i));
+	}
+	REQUIRE(!nibbles.exists("ca"));
+	REQUIRE(!nibbles.exists("\xc3"));
+	REQUIRE(nibbles.totalNodes() == 2 * bytes.totalNodes());
+
+	// same words in the same order as a byte trie
+	REQUIRE(nibbles.restOfString("") == bytes.restOfString(""));
+	REQUIRE(nibbles.restOfString("caf") == bytes.restOfString("caf"));
+	REQUIRE(nibbles.restOfString("\xc3") == bytes.restOfString("\xc3"));
+
+	REQUIRE(nibbles.remove("caf\xc3\xa9"));
+	REQUIRE(!nibbles.exists("caf\xc3\xa9"));
+	REQUIRE(nibbles.exists("cafe"));
+	REQUIRE(!nibbles.remove(""));
+}
+
+
+TEST_CASE("Testing FrozenTrie")
+{
+	// empty trie freezes into an empty frozen trie
+	Trie testingTrie = Trie();
+	FrozenTrie frozen = FrozenTrie(testingTrie);
+	REQUIRE(frozen.empty());
+	REQUIRE(!frozen.exists("a"));
+	REQUIRE(frozen.restOfString("").empty());
+
+	// frozen trie answers like the trie it came from
+	testingTrie.insert("yo");
+	testingTrie.insert("you");
+	testingTrie.insert("your");
+	testingTrie.insert("yours");
+	testingTrie.insert("abc");
+	testingTrie.insert(string(1, '\xff'));
+	frozen = FrozenTrie(testingTrie);
+	REQUIRE(frozen.size() == testingTrie.size());
+	REQUIRE(frozen.exists("you"));
+	REQUIRE(frozen.exists(string(1, '\xff')));
+	REQUIRE(!frozen.exists("y"));
+	REQUIRE(!frozen.exists("yourss"));
+	REQUIRE(!frozen.exists(""));
+	REQUIRE(frozen.restOfString("yo") == testingTrie.restOfString("yo"));
+	REQUIRE(frozen.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(frozen.restOfString("x").empty());
+
+	// later changes to the trie are not seen
+	testingTrie.insert("zebra");
+	REQUIRE(!frozen.exists("zebra"));
+
+	// nodes left behind by removed words are not frozen
+	REQUIRE(testingTrie.remove("abc"));
+	REQUIRE(testingTrie.remove("yours"));
+	frozen = FrozenTrie(testingTrie);
+	REQUIRE(frozen.size() == testingTrie.size());
+	REQUIRE(!frozen.exists("abc"));
+	REQUIRE(frozen.exists("your"));
+	REQUIRE(frozen.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(frozen.restOfString("a").empty());
+
+	// keys far longer than the call stack could walk one char at a time
+	string deep(1000000, 'f');
+	Trie deepTrie = Trie();
+	deepTrie.insert(deep);
+	deepTrie.insert(deep + "t");
+	FrozenTrie deepFrozen = FrozenTrie(deepTrie);
+	REQUIRE(deepFrozen.exists(deep + "t"));
+	vector<string> rest = deepFrozen.restOfString("ff");
+	REQUIRE(rest.size() == 2);
+	REQUIRE(rest[1] == deep + "t");
+}
+
+
+TEST_CASE("FrozenTrie HUGE DICTIONARY")
+{
+	Trie testingTrie = Trie();
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		testingTrie.insert(line);
+		words.push_back(line);
+	}
+
+	FrozenTrie frozen = FrozenTrie(testingTrie);
+	REQUIRE(frozen.size() == testingTrie.size());
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(frozen.exists(*i));
+		REQUIRE(frozen.exists(*i + "#") == testingTrie.exists(*i + "#"));
+		REQUIRE(frozen.exists(i->substr(1)) == testingTrie.exists(i->substr(1)));
+	}
+	REQUIRE(frozen.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(frozen.restOfString("pro") == testingTrie.restOfString("pro"));
+}
+
+
+TEST_CASE("Testing BitVector")
+{
+	// pattern with runs of set and clear bits across word boundaries
+	BitVector bits = BitVector();
+	vector<bool> expected;
+	for (size_t i = 0; i != 2000; ++i) {
+		bool bit = (i % 7 == 0) || (i / 100) % 2 == 1;
+		bits.push_back(bit);
+		expected.push_back(bit);
+	}
+	bits.build();
+	REQUIRE(bits.size() == expected.size());
+
+	size_t ones = 0;
+	size_t zeros = 0;
+	for (size_t i = 0; i != expected.size(); ++i) {
+		REQUIRE(bits[i] == expected[i]);
+		REQUIRE(bits.rank1(i) == ones);
+		if (expected[i]) {
+			++ones;
+		}
+		else {
+			++zeros;
+			REQUIRE(bits.select0(zeros) == i);
+		}
+	}
+	REQUIRE(bits.rank1(expected.size()) == ones);
+}
+
+
+TEST_CASE("Testing LoudsTrie")
+{
+	Trie testingTrie = Trie();
+	LoudsTrie empty = LoudsTrie(testingTrie);
+	REQUIRE(empty.empty());
+	REQUIRE(!empty.exists("a"));
+	REQUIRE(empty.restOfString("").empty());
+
+	testingTrie.insert("yo");
+	testingTrie.insert("you");
+	testingTrie.insert("your");
+	testingTrie.insert("yours");
+	testingTrie.insert("abc");
+	LoudsTrie louds = LoudsTrie(testingTrie);
+	REQUIRE(louds.size() == 5);
+	REQUIRE(louds.totalNodes() == testingTrie.totalNodes());
+	REQUIRE(louds.exists("yo"));
+	REQUIRE(louds.exists("abc"));
+	REQUIRE(!louds.exists("ab"));
+	REQUIRE(!louds.exists("yourself"));
+	REQUIRE(louds.restOfString("yo") == testingTrie.restOfString("yo"));
+	REQUIRE(louds.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(louds.restOfString("b").empty());
+
+	// nodes left behind by removed words are not encoded
+	REQUIRE(testingTrie.remove("abc"));
+	REQUIRE(testingTrie.remove("yours"));
+	LoudsTrie removed = LoudsTrie(testingTrie);
+	REQUIRE(removed.size() == 3);
+	REQUIRE(removed.totalNodes() == 4);
+	REQUIRE(!removed.exists("abc"));
+	REQUIRE(removed.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(removed.restOfString("a").empty());
+
+	// keys far longer than the call stack could walk one char at a time
+	string deep(1000000, 'l');
+	Trie deepTrie = Trie();
+	deepTrie.insert(deep);
+	deepTrie.insert(deep + "t");
+	LoudsTrie deepLouds = LoudsTrie(deepTrie);
+	REQUIRE(deepLouds.exists(deep + "t"));
+	vector<string> rest = deepLouds.restOfString("ll");
+	REQUIRE(rest.size() == 2);
+	REQUIRE(rest[1] == deep + "t");
+}
+
+
+TEST_CASE("LoudsTrie HUGE DICTIONARY")
+{
+	Trie testingTrie = Trie();
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		testingTrie.insert(line);
+		words.push_back(line);
+	}
+
+	LoudsTrie louds = LoudsTrie(testingTrie);
+	REQUIRE(louds.totalNodes() == testingTrie.totalNodes());
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(louds.exists(*i));
+		REQUIRE(louds.exists(i->substr(1)) == testingTrie.exists(i->substr(1)));
+	}
+	REQUIRE(louds.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(louds.restOfString("in") == testingTrie.restOfString("in"));
+}
+
+
+TEST_CASE("Testing Node Reuse")
+{
+	// nodes freed when unused nodes are removed get used again
+	Trie testingTrie = Trie();
+	vector<string> words;
+	for (size_t i = 0; i != 2 * MAXWORDSREMOVED; ++i) {
+		string word = "word" + to_string(i * 7919) + "end";
+		words.push_back(word);
+		testingTrie.insert(word);
+	}
+	size_t nodes = testingTrie.totalNodes();
+	size_t memory = testingTrie.memoryUsage();
+
+	for (size_t round = 0; round != 5; ++round) {
+		// removing every word frees every node
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			REQUIRE(testingTrie.remove(*i));
+		}
+		REQUIRE(testingTrie.totalNodes() == 0);
+
+		// inserting them again needs no more memory
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			testingTrie.insert(*i);
+		}
+		REQUIRE(testingTrie.totalNodes() == nodes);
+		REQUIRE(testingTrie.memoryUsage() == memory);
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			REQUIRE(testingTrie.exists(*i));
+		}
+	}
+}
+
+
+TEST_CASE("Testing Clone")
+{
+	// words with wide nodes, bitmaps and inline chains
+	Trie original = Trie();
+	vector<string> words;
+	for (size_t i = 0; i != 500; ++i) {
+		string word = to_string(i * 7919) + static_cast<char>('a' + i % 26);
+		words.push_back(word);
+		original.insert(word);
+	}
+	vector<string> all = original.restOfString("");
+
+	// a clone has the same words
+	Trie cloned = original.clone();
+	REQUIRE(cloned.size() == original.size());
+	REQUIRE(cloned.restOfString("") == all);
+
+	// changes to the clone stay in the clone
+	cloned.insert("zzz");
+	cloned.insert(words[0] + "x");
+	for (size_t i = 1; i != 2 * MAXWORDSREMOVED + 1; ++i) {
+		REQUIRE(cloned.remove(words[i]));
+	}
+	REQUIRE(!cloned.remove("zz"));
+	REQUIRE(cloned.size() == words.size() + 2 - 2 * MAXWORDSREMOVED);
+	REQUIRE(cloned.exists("zzz"));
+	REQUIRE(!cloned.exists(words[1]));
+	REQUIRE(original.size() == words.size());
+	REQUIRE(!original.exists("zzz"));
+	REQUIRE(!original.exists(words[0] + "x"));
+	REQUIRE(original.restOfString("") == all);
+
+	// changes to the original stay in the original
+	original.insert("yyy");
+	REQUIRE(original.remove(words[words.size() - 1]));
+	REQUIRE(original.exists("yyy"));
+	REQUIRE(!cloned.exists("yyy"));
+	REQUIRE(cloned.exists(words[words.size() - 1]));
+
+	// a clone of a clone. removing everything leaves the others alone
+	Trie second = cloned.clone();
+	size_t removed = 0;
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		removed += second.remove(*i) ? 1 : 0;
+	}
+	REQUIRE(second.remove("zzz"));
+	REQUIRE(second.remove(words[0] + "x"));
+	removed += 2;
+	while (removed % MAXWORDSREMOVED != 0) {
+		second.insert("q");
+		REQUIRE(second.remove("q"));
+		++removed;
+	}
+	REQUIRE(second.empty());
+	REQUIRE(second.totalNodes() == 0);
+	REQUIRE(cloned.exists("zzz"));
+	REQUIRE(cloned.exists(words[0]));
+	REQUIRE(original.exists(words[0]));
+	REQUIRE(!original.exists(words[words.size() - 1]));
+
+	// a copy shares nothing
+	Trie copy = cloned;
+	copy.removeAll();
+	REQUIRE(copy.empty());
+	REQUIRE(cloned.size() == words.size() + 2 - 2 * MAXWORDSREMOVED);
+	for (auto i = words.begin() + 2 * MAXWORDSREMOVED + 1; i != words.end(); ++i) {
+		REQUIRE(cloned.exists(*i));
+	}
+
+	// a moved from trie is empty and still works
+	Trie moved = std::move(copy);
+	REQUIRE(copy.empty());
+	REQUIRE(copy.restOfString("").empty());
+	copy.insert("abc");
+	REQUIRE(copy.exists("abc"));
+	moved = std::move(cloned);
+	REQUIRE(moved.exists("zzz"));
+	REQUIRE(cloned.empty());
+	REQUIRE(!cloned.exists("zzz"));
+	REQUIRE(!cloned.remove("zzz"));
+	cloned.insert("zzz");
+	REQUIRE(cloned.size() == 1);
+	REQUIRE(moved.size() == words.size() + 2 - 2 * MAXWORDSREMOVED);
+
+	// moving never allocates, so a growing vector moves its tries
+	static_assert(std::is_nothrow_move_constructible<Trie>::value, "Trie moves must not throw");
+	static_assert(std::is_nothrow_move_assignable<Trie>::value, "Trie moves must not throw");
+	vector<Trie> tries(1);
+	tries[0].insert("kept");
+	const Trie* before = &tries[0];
+	tries.resize(tries.capacity() + 1);
+	REQUIRE(&tries[0] != before);
+	REQUIRE(tries[0].exists("kept"));
+
+	// an empty trie and its clone each get their own arena on insert
+	Trie empty = Trie();
+	Trie emptyClone = empty.clone();
+	empty.insert("a");
+	emptyClone.insert("b");
+	REQUIRE(!empty.exists("b"));
+	REQUIRE(!emptyClone.exists("a"));
+	REQUIRE(!Trie().remove("a"));
+	REQUIRE(Trie().totalNodes() == 0);
+}
+
+
+TEST_CASE("Testing Relayout")
+{
+	// load in a scattered order, remove some words, then relayout
+	Trie testingTrie = Trie();
+	vector<string> words;
+	for (size_t i = 0; i != 2000; ++i) {
+		string word = to_string((i * 7919) % 10007) + static_cast<char>('a' + i % 26);
+		words.push_back(word);
+		testingTrie.insert(word);
+	}
+	for (size_t i = 0; i < words.size(); i += 3) {
+		REQUIRE(testingTrie.remove(words[i]));
+	}
+	Trie before = testingTrie.clone();
+	vector<string> all = testingTrie.restOfString("");
+	size_t memory = testingTrie.memoryUsage();
+
+	testingTrie.relayout();
+	REQUIRE(testingTrie.size() == all.size());
+	REQUIRE(testingTrie.restOfString("") == all);
+	REQUIRE(testingTrie.restOfString("12") == before.restOfString("12"));
+	REQUIRE(testingTrie.memoryUsage() <= memory);
+	for (size_t i = 0; i != words.size(); ++i) {
+		REQUIRE(testingTrie.exists(words[i]) == (i % 3 != 0));
+	}
+
+	// unused nodes are gone. a clone taken before keeps its own nodes
+	Trie pruned = before;
+	size_t removed = 0;
+	while ((removed + words.size() / 3 + 1) % MAXWORDSREMOVED != 0) {
+		pruned.insert("q");
+		REQUIRE(pruned.remove("q"));
+		++removed;
+	}
+	REQUIRE(testingTrie.totalNodes() == pruned.totalNodes());
+	REQUIRE(before.restOfString("") == all);
+
+	// still changes afterwards
+	for (size_t i = 0; i < words.size(); i += 3) {
+		testingTrie.insert(words[i]);
+	}
+	REQUIRE(testingTrie.remove(words[1]));
+	REQUIRE(testingTrie.size() == words.size() - 1);
+	REQUIRE(testingTrie.exists(words[0]));
+	REQUIRE(!testingTrie.exists(words[1]));
+
+	// empty and wide tries
+	Trie empty = Trie();
+	empty.relayout();
+	REQUIRE(empty.totalNodes() == 0);
+	empty.insert("a");
+	REQUIRE(empty.exists("a"));
+	Trie wide = Trie();
+	for (size_t c = 1; c != 256; ++c) {
+		wide.insert(string(1, static_cast<char>(c)) + "x");
+	}
+	all = wide.restOfString("");
+	wide.relayout();
+	REQUIRE(wide.restOfString("") == all);
+}
+
+
+TEST_CASE("Testing Deduplicate")
+{
+	// every stem takes every ending. the endings can all be shared
+	vector<string> stems = { "walk", "talk", "play", "jump", "cook", "paint", "climb", "call" };
+	vector<string> endings = { "", "s", "ed", "ing", "er", "ers", "able" };
+	Trie testingTrie = Trie();
+	for (auto i = stems.begin(); i != stems.end(); ++i) {
+		for (auto j = endings.begin(); j != endings.end(); ++j) {
+			testingTrie.insert(*i + *j);
+		}
+	}
+	Trie before = testingTrie.clone();
+	vector<string> all = testingTrie.restOfString("");
+	size_t nodes = testingTrie.totalNodes();
+	size_t memory = testingTrie.memoryUsage();
+
+	testingTrie.deduplicate();
+	REQUIRE(testingTrie.size() == all.size());
+	REQUIRE(testingTrie.restOfString("") == all);
+	REQUIRE(testingTrie.restOfString("pla") == before.restOfString("pla"));
+	REQUIRE(testingTrie.totalNodes() == nodes);
+	REQUIRE(testingTrie.memoryUsage() < memory / 2);
+
+	// merging again finds nothing new. relayout keeps the sharing
+	size_t merged = testingTrie.memoryUsage();
+	testingTrie.deduplicate();
+	REQUIRE(testingTrie.memoryUsage() == merged);
+	testingTrie.relayout();
+	REQUIRE(testingTrie.memoryUsage() == merged);
+	REQUIRE(testingTrie.restOfString("") == all);
+
+	// a change to a shared ending is only seen by its own word
+	REQUIRE(testingTrie.remove("walking"));
+	testingTrie.insert("talkingly");
+	REQUIRE(!testingTrie.exists("walking"));
+	REQUIRE(testingTrie.exists("talking"));
+	REQUIRE(testingTrie.exists("jumping"));
+	REQUIRE(testingTrie.exists("talkingly"));
+	REQUIRE(!testingTrie.exists("jumpingly"));
+	REQUIRE(testingTrie.size() == all.size());
+	for (size_t i = 0; i != 2 * MAXWORDSREMOVED; ++i) {
+		REQUIRE(testingTrie.remove(all[i]) == (all[i] != "walking"));
+	}
+	for (size_t i = 2 * MAXWORDSREMOVED; i != all.size(); ++i) {
+		REQUIRE(testingTrie.exists(all[i]) == (all[i] != "walking"));
+	}
+
+	// a clone taken before keeps its own nodes
+	REQUIRE(before.restOfString("") == all);
+}
+
+
+TEST_CASE("Testing string_view keys")
+{
+	// views into a bigger buffer. none of them end in a null char
+	string text = "carpetcartcarcarpets";
+	string_view view = text;
+	Trie testingTrie = Trie();
+	testingTrie.insert(view.substr(0, 6));
+	testingTrie.insert(view.substr(6, 4));
+	testingTrie.insert(view.substr(10, 3));
+	REQUIRE(testingTrie.size() == 3);
+	REQUIRE(testingTrie.exists("carpet"));
+	REQUIRE(testingTrie.exists(view.substr(13, 3)));
+	REQUIRE(!testingTrie.exists(view.substr(13, 7)));
+	vector<string> expected = { "carpet", "cart" };
+	REQUIRE(testingTrie.restOfString(view.substr(0, 3)) == expected);
+	REQUIRE(testingTrie.remove(view.substr(6, 4)));
+	REQUIRE(!testingTrie.exists("cart"));
+
+	// long keys that share most of their bytes, in every alphabet
+	string base(300, 'a');
+	BasicTrie<NibbleAlphabet> nibbles = BasicTrie<NibbleAlphabet>();
+	BasicTrie<LowerAsciiAlphabet> letters = BasicTrie<LowerAsciiAlphabet>();
+	for (char c = 'a'; c <= 'z'; ++c) {
+		testingTrie.insert(base + c);
+		nibbles.insert(base + c);
+		letters.insert(base + c);
+	}
+	REQUIRE(testingTrie.restOfString(base).size() == 26);
+	REQUIRE(nibbles.restOfString(base).size() == 26);
+	REQUIRE(letters.restOfString(base).size() == 26);
+	REQUIRE(nibbles.exists(base + 'q'));
+	REQUIRE(letters.remove(base + 'q'));
+	REQUIRE(!letters.exists(base + 'q'));
+	REQUIRE(!letters.exists(base + 'Q'));
+	REQUIRE(!nibbles.exists(base));
+}
+
+TEST_CASE("Testing deep keys")
+{
+	// far deeper than the call stack could go one char per call
+	string deep(1000000, 'g');
+	Trie testingTrie = Trie();
+	testingTrie.insert(deep);
+	testingTrie.insert(deep + "t");
+	REQUIRE(testingTrie.exists(deep));
+	REQUIRE(!testingTrie.exists(deep.substr(1)));
+	REQUIRE(testingTrie.totalNodes() == deep.size() + 1);
+	vector<string> rest = testingTrie.restOfString("ggg");
+	REQUIRE(rest.size() == 2);
+	REQUIRE(rest[1] == deep + "t");
+
+	// a clone changes its own copy of the path
+	Trie copy = testingTrie.clone();
+	REQUIRE(copy.remove(deep));
+	REQUIRE(testingTrie.exists(deep));
+	testingTrie.relayout();
+	testingTrie.deduplicate();
+	REQUIRE(testingTrie.exists(deep + "t"));
+
+	// removing the long word takes its nodes away once unused nodes go
+	size_t removed = 0;
+	REQUIRE(testingTrie.remove(deep + "t"));
+	REQUIRE(testingTrie.remove(deep));
+	for (removed = 2; removed % MAXWORDSREMOVED != 0; ++removed) {
+		testingTrie.insert("q");
+		testingTrie.remove("q");
+	}
+	REQUIRE(testingTrie.empty());
+	REQUIRE(testingTrie.totalNodes() == 0);
+
+	// branches at every level, split in two levels per char
+	BasicTrie<NibbleAlphabet> nibbles = BasicTrie<NibbleAlphabet>();
+	for (size_t length = 1; length != 1000; ++length) {
+		nibbles.insert(string(length, 'a') + 'b');
+	}
+	nibbles.relayout();
+	nibbles.deduplicate();
+	REQUIRE(nibbles.size() == 999);
+	REQUIRE(nibbles.exists(string(998, 'a') + 'b'));
+	REQUIRE(nibbles.restOfString(string(500, 'a')).size() == 500);
+}
+
+TEST_CASE("Testing forEachCompletion")
+{
+	Trie testingTrie = Trie();
+	vector<string> words = { "yo", "you", "your", "yours", "young", "abc" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		testingTrie.insert(*i);
+	}
+
+	// same words and order as restOfString
+	vector<string> visited;
+	testingTrie.forEachCompletion("yo", [&](const string& word) {
+		visited.push_back(word);
+	});
+	vector<string> expected = { "you", "young", "your", "yours" };
+	REQUIRE(visited == expected);
+	REQUIRE(testingTrie.restOfString("yo") == expected);
+
+	// the callback can take the word by value and keep it
+	size_t chars = 0;
+	testingTrie.forEachCompletion("", [&](string word) {
+		chars += word.size();
+	});
+	REQUIRE(chars == 22);
+	testingTrie.forEachCompletion("zz", [&](const string&) {
+		FAIL("no word starts with zz");
+	});
+	testingTrie.forEachCompletion("y\xff", [&](const string&) {
+		FAIL("no word starts with y\\xff");
+	});
+
+	// output iterators append in place
+	vector<string> output = { "first" };
+	testingTrie.restOfString("your", back_inserter(output));
+	expected = { "first", "yours" };
+	REQUIRE(output == expected);
+	ostringstream joined;
+	testingTrie.restOfString("you", ostream_iterator<string>(joined, ","));
+	REQUIRE(joined.str() == "young,your,yours,");
+	string fixed[4];
+	REQUIRE(testingTrie.restOfString("yo", fixed) == fixed + 4);
+	REQUIRE(fixed[3] == "yours");
+
+	// other alphabets turn their symbols back into chars
+	BasicTrie<NibbleAlphabet> nibbles = BasicTrie<NibbleAlphabet>();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		nibbles.insert(*i);
+	}
+	visited.clear();
+	nibbles.restOfString("yo", back_inserter(visited));
+	REQUIRE(visited == testingTrie.restOfString("yo"));
+}
+
+TEST_CASE("Testing completions")
+{
+	Trie testingTrie = Trie();
+	vector<string> words = { "yo", "you", "your", "yours", "young", "abc", "yoga" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		testingTrie.insert(*i);
+	}
+
+	// range-for gives what restOfString gives
+	vector<string> walked;
+	for (const string& word : testingTrie.completions("yo")) {
+		walked.push_back(word);
+	}
+	REQUIRE(walked == testingTrie.restOfString("yo"));
+	walked.clear();
+	for (const string& word : testingTrie.completions("")) {
+		walked.push_back(word);
+	}
+	REQUIRE(walked == testingTrie.restOfString(""));
+	REQUIRE(testingTrie.completions("zz").begin() == testingTrie.completions("zz").end());
+	REQUIRE(testingTrie.completions("yours").begin() == testingTrie.completions("yours").end());
+	REQUIRE(testingTrie.completions("y\xff").begin() == testingTrie.completions("y\xff").end());
+
+	// the prefix is copied, and every begin starts over
+	string prefix = "you";
+	Trie::Completions range = testingTrie.completions(prefix);
+	prefix = "abc";
+	Trie::CompletionIterator i = range.begin();
+	REQUIRE(*i == "young");
+	REQUIRE(i->size() == 5);
+	REQUIRE(*i++ == "young");
+	REQUIRE(*i == "your");
+	REQUIRE(*range.begin() == "young");
+	++i;
+	++i;
+	REQUIRE(i == range.end());
+
+	// stopping early leaves the rest of the subtree alone
+	BasicTrie<NibbleAlphabet> nibbles = BasicTrie<NibbleAlphabet>();
+	for (auto w = words.begin(); w != words.end(); ++w) {
+		nibbles.insert(*w);
+	}
+	walked.clear();
+	for (const string& word : nibbles.completions("y")) {
+		walked.push_back(word);
+		if (walked.size() == 2) {
+			break;
+		}
+	}
+	vector<string> expected = { "yo", "yoga" };
+	REQUIRE(walked == expected);
+
+#ifdef __cpp_lib_ranges
+	// works with the standard range adaptors
+	walked.clear();
+	for (const string& word : testingTrie.completions("yo") | std::views::take(3)) {
+		walked.push_back(word);
+	}
+	expected = { "yoga", "you", "young" };
+	REQUIRE(walked == expected);
+	auto kept = testingTrie.completions("");
+	REQUIRE(std::ranges::distance(kept | std::views::take(100)) == 7);
+	static_assert(std::input_iterator<Trie::CompletionIterator>);
+	static_assert(std::sentinel_for<Trie::CompletionSentinel, Trie::CompletionIterator>);
+#endif
+}
+
+TEST_CASE("Completions HUGE DICTIONARY")
+{
+	Trie testingTrie = Trie();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	string line;
+	vector<string> prefixes;
+	while (getline(inFile, line)) {
+		testingTrie.insert(line);
+		prefixes.push_back(line.substr(0, 2));
+	}
+
+	// every prefix walks the same words as restOfString
+	for (size_t i = 0; i < prefixes.size(); i += 50) {
+		vector<string> walked;
+		for (const string& word : testingTrie.completions(prefixes[i])) {
+			walked.push_back(word);
+		}
+		REQUIRE(walked == testingTrie.restOfString(prefixes[i]));
+	}
+}
+
+TEST_CASE("Testing Dawg")
+{
+	// shared suffixes become shared nodes
+	vector<string> words = { "tap", "taps", "top", "tops" };
+	Dawg graph = Dawg(words);
+	REQUIRE(graph.size() == 4);
+	REQUIRE(graph.totalNodes() == 4);
+	REQUIRE(graph.exists("tap"));
+	REQUIRE(graph.exists("tops"));
+	REQUIRE(!graph.exists("to"));
+	REQUIRE(!graph.exists("tas"));
+	REQUIRE(graph.restOfString("") == words);
+	vector<string> expected = { "top", "tops" };
+	REQUIRE(graph.restOfString("to") == expected);
+	REQUIRE(graph.restOfString("x").empty());
+
+	// words out of order are refused
+	vector<string> unsorted = { "b", "a" };
+	REQUIRE_THROWS_AS(Dawg(unsorted), std::invalid_argument);
+
+	// repeats and empty words are skipped
+	vector<string> repeats = { "", "a", "a", "ab" };
+	Dawg small = Dawg(repeats);
+	REQUIRE(small.size() == 2);
+	REQUIRE(Dawg().empty());
+
+	// keys far longer than the call stack could walk one char at a time
+	string deep(1000000, 'd');
+	Trie deepTrie = Trie();
+	deepTrie.insert(deep);
+	deepTrie.insert(deep + "t");
+	Dawg deepGraph = Dawg(deepTrie);
+	REQUIRE(deepGraph.size() == 2);
+	REQUIRE(deepGraph.exists(deep + "t"));
+	REQUIRE(!deepGraph.exists(deep + "d"));
+	vector<string> rest = deepGraph.restOfString("dd");
+	REQUIRE(rest.size() == 2);
+	REQUIRE(rest[1] == deep + "t");
+}
+
+
+TEST_CASE("Dawg HUGE DICTIONARY")
+{
+	Trie testingTrie = Trie();
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		testingTrie.insert(line);
+		words.push_back(line);
+	}
+
+	Dawg graph = Dawg(testingTrie);
+	REQUIRE(graph.size() == testingTrie.size());
+	REQUIRE(graph.totalNodes() < testingTrie.totalNodes() / 2);
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		REQUIRE(graph.exists(*i));
+		REQUIRE(graph.exists(i->substr(1)) == testingTrie.exists(i->substr(1)));
+		REQUIRE(graph.exists(*i + "s") == testingTrie.exists(*i + "s"));
+	}
+	REQUIRE(graph.restOfString("") == testingTrie.restOfString(""));
+	REQUIRE(graph.restOfString("re") == testingTrie.restOfString("re"));
+}
+
+
+TEST_CASE("Testing EdgeBlock")
+{
+	struct Edge {
+		char key_;
+		uint32_t node_;
+	};
+	vector<Edge> edges;
+	EdgeBlock::FreeLists free;
+
+	// blocks come out sorted and double as they fill up
+	uint32_t first = 0;
+	uint16_t count = 0;
+	uint16_t capacity = 0;
+	string keys = "dbca";
+	for (size_t i = 0; i != keys.size(); ++i) {
+		EdgeBlock::insert(edges, free, first, count, capacity, Edge{ keys[i], static_cast<uint32_t>(i) });
+	}
+	REQUIRE(count == 4);
+	REQUIRE(capacity == 4);
+	for (size_t i = 0; i != count; ++i) {
+		REQUIRE(edges[first + i].key_ == static_cast<char>('a' + i));
+	}
+	REQUIRE(EdgeBlock::find(edges, first, count, 'c') == first + 2);
+	REQUIRE(EdgeBlock::find(edges, first, count, 'e') == edges.size());
+
+	// blocks left behind by a move are handed out before the arena grows.
+	//  only the block of 4 is new
+	size_t arena = edges.size();
+	uint32_t other = 0;
+	uint16_t otherCount = 0;
+	uint16_t otherCapacity = 0;
+	for (size_t i = 0; i != keys.size(); ++i) {
+		EdgeBlock::insert(edges, free, other, otherCount, otherCapacity, Edge{ keys[i], 0 });
+	}
+	REQUIRE(edges.size() == arena + 4);
+	arena = edges.size();
+
+	// copies round their room up to a power of two and reuse released blocks
+	EdgeBlock::release(free, first, capacity);
+	uint32_t copied = 0;
+	uint16_t copiedCapacity = 0;
+	EdgeBlock::copy(edges, free, other, 3, copied, copiedCapacity);
+	REQUIRE(copiedCapacity == 4);
+	REQUIRE(copied == first);
+	REQUIRE(edges.size() == arena);
+	REQUIRE(edges[copied + 2].key_ == 'c');
+}
+
+
+TEST_CASE("Testing BurstTrie")
+{
+	// small limit so buckets burst quickly
+	BurstTrie testingTrie = BurstTrie(2);
+	testingTrie.insert("hello");
+	testingTrie.insert("help");
+	REQUIRE(testingTrie.totalNodes() == 1);
+	REQUIRE(testingTrie.exists("hello"));
+	REQUIRE(!testingTrie.exists("hel"));
+	testingTrie.insert("help");
+	REQUIRE(testingTrie.size() == 2);
+
+	// third suffix bursts the bucket
+	testingTrie.insert("hex");
+	REQUIRE(testingTrie.totalNodes() > 1);
+	testingTrie.insert("h");
+	testingTrie.insert("he");
+	REQUIRE(testingTrie.size() == 5);
+	vector<string> expected = { "h", "he", "hello", "help", "hex" };
+	REQUIRE(testingTrie.restOfString("") == expected);
+	expected = { "hello", "help" };
+	REQUIRE(testingTrie.restOfString("hel") == expected);
+	expected = { "hello" };
+	REQUIRE(testingTrie.restOfString("hell") == expected);
+	REQUIRE(testingTrie.restOfString("hello").empty());
+	REQUIRE(testingTrie.restOfString("z").empty());
+
+	// remove from buckets and from nodes
+	REQUIRE(testingTrie.remove("help"));
+	REQUIRE(!testingTrie.remove("help"));
+	REQUIRE(testingTrie.remove("he"));
+	REQUIRE(!testingTrie.exists("he"));
+	REQUIRE(testingTrie.exists("hello"));
+	REQUIRE(testingTrie.size() == 3);
+}
+
+
+TEST_CASE("BurstTrie HUGE DICTIONARY")
+{
+	Trie trie = Trie();
+	BurstTrie burst = BurstTrie();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		trie.insert(line);
+		burst.insert(line);
+		words.push_back(line);
+	}
+	REQUIRE(burst.size() == trie.size());
+	REQUIRE(burst.totalNodes() < trie.totalNodes());
+	REQUIRE(burst.restOfString("") == trie.restOfString(""));
+	REQUIRE(burst.restOfString("st") == trie.restOfString("st"));
+	burst.showStatistics(cout);
+
+	// remove every other word
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(burst.remove(words[i]));
+		REQUIRE(trie.remove(words[i]));
+	}
+	for (size_t i = 0; i != words.size(); ++i) {
+		REQUIRE(burst.exists(words[i]) == (i % 2 == 1));
+	}
+	REQUIRE(burst.restOfString("") == trie.restOfString(""));
+	REQUIRE(burst.restOfString("ma") == trie.restOfString("ma"));
+
+	// removing and inserting every word again reuses the nodes, edge
+	//  blocks and buckets once the buckets have grown back
+	for (size_t i = 0; i < words.size(); i += 2) {
+		burst.insert(words[i]);
+	}
+	size_t memory = 0;
+	for (size_t round = 0; round != 4; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			REQUIRE(burst.remove(*i));
+		}
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			burst.insert(*i);
+		}
+		if (round == 0) {
+			memory = burst.memoryUsage();
+		}
+	}
+	REQUIRE(burst.memoryUsage() == memory);
+	REQUIRE(burst.size() == words.size());
+}
+
+
+TEST_CASE("Testing HatTrie")
+{
+	// small limit so buckets burst quickly
+	HatTrie testingTrie = HatTrie(20);
+	vector<string> words = { "bat", "bath", "bat", "batch", "be", "bee", "beer", "b", "zoo" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		testingTrie.insert(*i);
+	}
+	REQUIRE(testingTrie.size() == 8);
+	REQUIRE(testingTrie.totalNodes() == 2);
+	REQUIRE(testingTrie.exists("batch"));
+	REQUIRE(!testingTrie.exists("ba"));
+	vector<string> expected = { "bat", "batch", "bath" };
+	REQUIRE(testingTrie.restOfString("ba") == expected);
+	expected = { "batch", "bath" };
+	REQUIRE(testingTrie.restOfString("bat") == expected);
+
+	// enough words under "b" to burst its table
+	for (char c = 'a'; c <= 'z'; ++c) {
+		testingTrie.insert(string("bo") + c);
+	}
+	REQUIRE(testingTrie.size() == 34);
+	REQUIRE(testingTrie.totalNodes() > 2);
+	expected = { "bat", "batch", "bath", "be", "bee", "beer", "boa" };
+	vector<string> found = testingTrie.restOfString("b");
+	REQUIRE(vector<string>(found.begin(), found.begin() + 7) == expected);
+	REQUIRE(found.size() == 32);
+	REQUIRE(std::is_sorted(found.begin(), found.end()));
+
+	// remove from tables and from nodes
+	REQUIRE(testingTrie.remove("b"));
+	REQUIRE(!testingTrie.remove("b"));
+	REQUIRE(testingTrie.remove("beer"));
+	REQUIRE(!testingTrie.exists("beer"));
+	REQUIRE(testingTrie.exists("bee"));
+	REQUIRE(testingTrie.size() == 32);
+	testingTrie.removeAll();
+	REQUIRE(testingTrie.empty());
+	REQUIRE(!testingTrie.exists("bee"));
+}
+
+
+TEST_CASE("HatTrie HUGE DICTIONARY")
+{
+	Trie trie = Trie();
+	HatTrie hat = HatTrie(256);
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		trie.insert(line);
+		hat.insert(line);
+		words.push_back(line);
+	}
+	REQUIRE(hat.size() == trie.size());
+	REQUIRE(hat.restOfString("") == trie.restOfString(""));
+	REQUIRE(hat.restOfString("st") == trie.restOfString("st"));
+	hat.showStatistics(cout);
+
+	// remove every other word
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(hat.remove(words[i]));
+		REQUIRE(trie.remove(words[i]));
+	}
+	for (size_t i = 0; i != words.size(); ++i) {
+		REQUIRE(hat.exists(words[i]) == (i % 2 == 1));
+	}
+	REQUIRE(hat.restOfString("") == trie.restOfString(""));
+	REQUIRE(hat.restOfString("ma") == trie.restOfString("ma"));
+
+	// removing and inserting every word again reuses the nodes, edge
+	//  blocks and tables once the tables have grown back
+	for (size_t i = 0; i < words.size(); i += 2) {
+		hat.insert(words[i]);
+	}
+	size_t memory = 0;
+	for (size_t round = 0; round != 4; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			REQUIRE(hat.remove(*i));
+		}
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			hat.insert(*i);
+		}
+		if (round == 0) {
+			memory = hat.memoryUsage();
+		}
+	}
+	REQUIRE(hat.memoryUsage() == memory);
+	REQUIRE(hat.size() == words.size());
+}
+
+
+TEST_CASE("Testing PersistentTrie")
+{
+	PersistentTrie empty = PersistentTrie();
+	REQUIRE(empty.empty());
+	REQUIRE(empty.totalNodes() == 0);
+
+	// every change is a new version
+	PersistentTrie first = empty.insert("you").insert("your").insert("yours");
+	PersistentTrie second = first.insert("abc").remove("your");
+	REQUIRE(empty.size() == 0);
+	REQUIRE(!empty.exists("you"));
+	REQUIRE(first.size() == 3);
+	REQUIRE(first.exists("your"));
+	REQUIRE(!first.exists("abc"));
+	REQUIRE(second.size() == 3);
+	REQUIRE(second.exists("abc"));
+	REQUIRE(!second.exists("your"));
+	REQUIRE(second.exists("yours"));
+
+	vector<string> expected = { "your", "yours" };
+	REQUIRE(first.restOfString("you") == expected);
+	expected = { "yours" };
+	REQUIRE(second.restOfString("you") == expected);
+	expected = { "abc", "you", "yours" };
+	REQUIRE(second.restOfString("") == expected);
+
+	// no change gives back the same version
+	REQUIRE(first.insert("you").size() == 3);
+	REQUIRE(first.insert("").size() == 3);
+	REQUIRE(first.remove("yo").size() == 3);
+
+	// nodes that lead to no word go right away
+	PersistentTrie third = second.remove("yours").remove("abc");
+	REQUIRE(third.totalNodes() == 3);
+	REQUIRE(third.remove("you").totalNodes() == 0);
+	REQUIRE(third.remove("you").empty());
+
+	// same words as a Trie, in the same order
+	Trie trie = Trie();
+	PersistentTrie version = PersistentTrie();
+	for (size_t i = 0; i != 300; ++i) {
+		string word = to_string(i * 7919) + static_cast<char>(200 + i % 50);
+		trie.insert(word);
+		version = version.insert(word);
+	}
+	REQUIRE(version.size() == trie.size());
+	REQUIRE(version.totalNodes() == trie.totalNodes());
+	REQUIRE(version.restOfString("") == trie.restOfString(""));
+	REQUIRE(version.restOfString("1") == trie.restOfString("1"));
+
+	// far deeper than the call stack could go one char per call
+	string deep(1000000, 'g');
+	PersistentTrie shallow = PersistentTrie().insert("g");
+	PersistentTrie deeper = shallow.insert(deep).insert(deep + "t");
+	REQUIRE(deeper.exists(deep));
+	REQUIRE(deeper.totalNodes() == deep.size() + 1);
+	REQUIRE(deeper.restOfString("gg").size() == 2);
+	REQUIRE(deeper.memoryUsage() > deep.size());
+	PersistentTrie shorter = deeper.remove(deep + "t");
+	REQUIRE(shorter.totalNodes() == deep.size());
+	REQUIRE(shorter.remove(deep).totalNodes() == 1);
+	REQUIRE(deeper.exists(deep + "t"));
+
+	// a static live trie lets go of its deep version at exit
+	static LiveTrie kept;
+	kept.publish(deeper);
+	deeper = PersistentTrie();
+	shorter = PersistentTrie();
+	REQUIRE(shallow.exists("g"));
+	REQUIRE(kept.snapshot().exists(deep));
+}
+
+TEST_CASE("LiveTrie HUGE DICTIONARY")
+{
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		words.push_back(line);
+	}
+
+	// readers look up words while a writer inserts them in order. a
+	//  snapshot never changes, and later ones hold every earlier word
+	LiveTrie live = LiveTrie();
+	atomic<bool> done(false);
+	atomic<size_t> failures(0);
+	vector<thread> readers;
+	for (size_t r = 0; r != 2; ++r) {
+		readers.push_back(thread([&]() {
+			size_t seen = 0;
+			while (!done) {
+				PersistentTrie snapshot = live.snapshot();
+				size_t size = snapshot.size();
+				if (size < seen || (size != 0 && !snapshot.exists(words[size - 1]))) {
+					++failures;
+				}
+				if (size != 0 && !live.exists(words[size - 1])) {
+					++failures;
+				}
+				if (snapshot.size() != size) {
+					++failures;
+				}
+				seen = size;
+			}
+		}));
+	}
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		live.insert(*i);
+	}
+	done = true;
+	for (auto i = readers.begin(); i != readers.end(); ++i) {
+		i->join();
+	}
+	REQUIRE(failures == 0);
+
+	Trie trie = Trie();
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		trie.insert(*i);
+	}
+	PersistentTrie loaded = live.snapshot();
+	REQUIRE(loaded.size() == trie.size());
+	REQUIRE(live.restOfString("") == trie.restOfString(""));
+	REQUIRE(live.restOfString("st") == trie.restOfString("st"));
+
+	// an old version outlives the words removed after it
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(live.remove(words[i]));
+	}
+	REQUIRE(!live.remove(words[0]));
+	for (size_t i = 0; i != words.size(); ++i) {
+		REQUIRE(live.exists(words[i]) == (i % 2 == 1));
+		REQUIRE(loaded.exists(words[i]));
+	}
+}
+
+TEST_CASE("Testing TrieMap")
+{
+	TrieMap<int> testingMap = TrieMap<int>();
+	REQUIRE(testingMap.empty());
+	REQUIRE(testingMap.find("you") == nullptr);
+
+	// new keys and replaced values
+	REQUIRE(testingMap.insert("you", 1));
+	REQUIRE(testingMap.insert("your", 2));
+	REQUIRE(testingMap.insert("yours", 3));
+	REQUIRE(testingMap.insert("abc", 4));
+	REQUIRE(!testingMap.insert("your", 20));
+	REQUIRE(testingMap.size() == 4);
+	REQUIRE(*testingMap.find("your") == 20);
+	REQUIRE(testingMap.find("yo") == nullptr);
+	REQUIRE(testingMap.find("yourself") == nullptr);
+	REQUIRE(!testingMap.exists(""));
+	*testingMap.find("you") += 10;
+	REQUIRE(*testingMap.find("you") == 11);
+
+	// pairs come out in key order, the prefix first
+	vector<pair<string, int> > expected = { { "you", 11 }, { "your", 20 }, { "yours", 3 } };
+	REQUIRE(testingMap.prefix("you") == expected);
+	expected = { { "abc", 4 }, { "you", 11 }, { "your", 20 }, { "yours", 3 } };
+	REQUIRE(testingMap.prefix("") == expected);
+	REQUIRE(testingMap.prefix("b").empty());
+
+	// the empty key is a key too
+	REQUIRE(testingMap.insert("", 0));
+	REQUIRE(*testingMap.find("") == 0);
+	REQUIRE(testingMap.prefix("").size() == 5);
+
+	// removing keeps every other value where it was
+	REQUIRE(testingMap.remove("you"));
+	REQUIRE(!testingMap.remove("you"));
+	REQUIRE(!testingMap.remove("yo"));
+	REQUIRE(testingMap.find("you") == nullptr);
+	REQUIRE(*testingMap.find("your") == 20);
+	REQUIRE(*testingMap.find("yours") == 3);
+	REQUIRE(*testingMap.find("abc") == 4);
+	REQUIRE(testingMap.remove(""));
+	REQUIRE(testingMap.size() == 3);
+
+	testingMap.removeAll();
+	REQUIRE(testingMap.empty());
+	REQUIRE(testingMap.totalNodes() == 0);
+	REQUIRE(testingMap.find("abc") == nullptr);
+
+	// keys far longer than the call stack could walk one char at a time
+	string deep(1000000, 'm');
+	REQUIRE(testingMap.insert(deep, 1));
+	REQUIRE(testingMap.insert(deep + "n", 2));
+	REQUIRE(testingMap.totalNodes() == deep.size() + 1);
+	REQUIRE(testingMap.prefix(deep).size() == 2);
+	REQUIRE(testingMap.prefix("m").back().second == 2);
+	REQUIRE(testingMap.remove(deep + "n"));
+	for (size_t i = 1; i != MAXWORDSREMOVED; ++i) {
+		REQUIRE(testingMap.insert("x", 0));
+		REQUIRE(testingMap.remove("x"));
+	}
+	REQUIRE(testingMap.totalNodes() == deep.size());
+	REQUIRE(*testingMap.find(deep) == 1);
+}
+
+TEST_CASE("TrieMap HUGE DICTIONARY")
+{
+	Trie trie = Trie();
+	TrieMap<string> testingMap = TrieMap<string>();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		trie.insert(line);
+		testingMap.insert(line, to_string(words.size()));
+		words.push_back(line);
+	}
+	REQUIRE(testingMap.size() == trie.size());
+	REQUIRE(testingMap.totalNodes() == trie.totalNodes());
+	vector<pair<string, string> > pairs = testingMap.prefix("st");
+	vector<string> keys;
+	for (auto i = pairs.begin(); i != pairs.end(); ++i) {
+		keys.push_back(i->first);
+	}
+	vector<string> expected = trie.restOfString("st");
+	expected.insert(expected.begin(), "st"); // prefix has the prefix too
+	REQUIRE(trie.exists("st"));
+	REQUIRE(keys == expected);
+
+	// remove every other word, then check every value
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(testingMap.remove(words[i]));
+		REQUIRE(trie.remove(words[i]));
+	}
+	for (size_t i = 0; i != words.size(); ++i) {
+		const string* value = testingMap.find(words[i]);
+		REQUIRE((value != nullptr) == (i % 2 == 1));
+		if (value != nullptr) {
+			REQUIRE(*value == to_string(i));
+		}
+	}
+	REQUIRE(testingMap.totalNodes() == trie.totalNodes());
+
+	// freed nodes are used again
+	size_t memory = testingMap.memoryUsage();
+	for (size_t i = 0; i < words.size(); i += 2) {
+		REQUIRE(testingMap.insert(words[i], "again"));
+	}
+	REQUIRE(testingMap.memoryUsage() <= memory);
+	REQUIRE(*testingMap.find(words[0]) == "again");
+
+	// removing and inserting every key again reuses the nodes and blocks
+	memory = testingMap.memoryUsage();
+	for (size_t round = 0; round != 3; ++round) {
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			testingMap.remove(*i);
+		}
+		REQUIRE(testingMap.totalNodes() == 0);
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			testingMap.insert(*i, *i);
+		}
+	}
+	REQUIRE(testingMap.memoryUsage() == memory);
+	REQUIRE(*testingMap.find(words[1]) == words[1]);
+}
+
+TEST_CASE("Testing SuffixAutomaton")
+{
+	SuffixAutomaton automaton = SuffixAutomaton();
+	REQUIRE(automaton.containing("a").empty());
+
+	vector<string> words = { "banana", "bandana", "cabana", "ananas", "nab" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		automaton.insert(*i);
+	}
+	automaton.insert("banana");
+	automaton.insert("");
+	REQUIRE(automaton.size() == 5);
+	REQUIRE(automaton.exists("cabana"));
+	REQUIRE(!automaton.exists("cab"));
+	vector<string> expected = { "banana", "bandana" };
+	REQUIRE(automaton.restOfString("ban") == expected);
+
+	// words come out in the order they were inserted
+	expected = { "banana", "ananas" };
+	REQUIRE(automaton.containing("nana") == expected);
+	expected = { "banana", "bandana", "cabana", "ananas" };
+	REQUIRE(automaton.containing("ana") == expected);
+	expected = { "bandana" };
+	REQUIRE(automaton.containing("nda") == expected);
+	expected = { "cabana", "nab" };
+	REQUIRE(automaton.containing("ab") == expected);
+	expected = { "ananas" };
+	REQUIRE(automaton.containing("ananas") == expected);
+	REQUIRE(automaton.containing("ananass").empty());
+	REQUIRE(automaton.containing("x").empty());
+	REQUIRE(automaton.containing("") == words);
+}
+
+TEST_CASE("SuffixAutomaton HUGE DICTIONARY")
+{
+	SuffixAutomaton automaton = SuffixAutomaton();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		automaton.insert(line);
+		words.push_back(line);
+	}
+	REQUIRE(automaton.size() == words.size());
+
+	// same words as a scan over every word, in the same order
+	vector<string> fragments = { "ing", "tion", "qu", "ss", "x", "zz", "ment", "e", "abcd", "the" };
+	for (size_t i = 0; i < words.size(); i += 97) {
+		fragments.push_back(words[i].substr(words[i].size() / 3, 3));
+	}
+	for (auto f = fragments.begin(); f != fragments.end(); ++f) {
+		vector<string> expected;
+		for (auto i = words.begin(); i != words.end(); ++i) {
+			if (i->find(*f) != string::npos) {
+				expected.push_back(*i);
+			}
+		}
+		REQUIRE(automaton.containing(*f) == expected);
+	}
+
+	// at most two states per char
+	size_t chars = 0;
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		chars += i->size();
+	}
+	REQUIRE(automaton.totalStates() <= 2 * chars);
+}
+
+TEST_CASE("Testing TwoWayTrie")
+{
+	TwoWayTrie testingTrie = TwoWayTrie();
+	vector<string> words = { "index.html", "main.cpp", "trie.cpp", "trie.hpp", "cpp", "notes.txt" };
+	for (auto i = words.begin(); i != words.end(); ++i) {
+		testingTrie.insert(*i);
+	}
+	REQUIRE(testingTrie.size() == words.size());
+	REQUIRE(testingTrie.exists("main.cpp"));
+
+	// suffix itself is left out, like the prefix is for restOfString.
+	//  words come out in order of their reversed spelling
+	vector<string> expected = { "trie.cpp", "main.cpp" };
+	REQUIRE(testingTrie.endingWith(".cpp") == expected);
+	REQUIRE(testingTrie.endingWith("cpp") == expected);
+	expected = { "trie.cpp", "trie.hpp" };
+	REQUIRE(testingTrie.restOfString("trie") == expected);
+	REQUIRE(testingTrie.endingWith(".java").empty());
+
+	// remove keeps both directions in step
+	REQUIRE(testingTrie.remove("main.cpp"));
+	REQUIRE(!testingTrie.remove("main.cpp"));
+	expected = { "trie.cpp" };
+	REQUIRE(testingTrie.endingWith(".cpp") == expected);
+	testingTrie.removeAll();
+	REQUIRE(testingTrie.empty());
+	REQUIRE(testingTrie.endingWith("p").empty());
+	REQUIRE(testingTrie.totalNodes() == 0);
+}
+
+TEST_CASE("TwoWayTrie HUGE DICTIONARY")
+{
+	TwoWayTrie testingTrie = TwoWayTrie();
+
+	ifstream inFile("google-10000-english.txt");
+	if (!inFile) {
+		cerr << "Couldn't open file. Exiting" << endl;
+		exit(1);
+	}
+	vector<string> words;
+	string line;
+	while (getline(inFile, line)) {
+		testingTrie.insert(line);
+		words.push_back(line);
+	}
+
+	// same words as a scan, once both are sorted
+	vector<string> endings = { "ing", "tion", "s", "ly", "zzz", "x" };
+	for (size_t round = 0; round != 2; ++round) {
+		for (auto e = endings.begin(); e != endings.end(); ++e) {
+			vector<string> expected;
+			for (auto i = words.begin(); i != words.end(); ++i) {
+				if (i->size() > e->size() && i->compare(i->size() - e->size(), e->size(), *e) == 0
+					&& testingTrie.exists(*i)) {
+					expected.push_back(*i);
+				}
+			}
+			vector<string> found = testingTrie.endingWith(*e);
+			sort(found.begin(), found.end());
+			sort(expected.begin(), expected.end());
+			REQUIRE(found == expected);
+		}
+
+		// then again with every other word gone
+		for (size_t i = 0; round == 0 && i < words.size(); i += 2) {
+			REQUIRE(testingTrie.remove(words[i]));
+		}
+	}
+}
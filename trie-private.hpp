@@ -0,0 +1,1160 @@
+/**
+* \file trie-private.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for trie.hpp. Included at the end of trie.hpp
+*/
+#include "bitvector.hpp" // popcount64, lowestBit64
+#include <algorithm> // fill, copy_backward, max, reverse
+#include <iterator> // back_inserter
+#include <stdexcept> // length_error, invalid_argument
+
+// SSE2 is used to search NODE16 blocks when the compiler targets it
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TRIE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+///////////////////////////////////////////////////////////////
+///////////// BasicTrie Implementation ////////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename Alphabet>
+const size_t BasicTrie<Alphabet>::CAPACITY[] = { 0, INLINECHILDREN, 4, 16, 48, Alphabet::SIZE };
+
+template <typename Alphabet>
+const size_t BasicTrie<Alphabet>::KEYWORDS[] = { 0, 0, 1, 4, 8, 0 };
+
+template <typename Alphabet>
+const typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::ROOT;
+template <typename Alphabet>
+const uint32_t BasicTrie<Alphabet>::NOBLOCK;
+template <typename Alphabet>
+const typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::UNSEEN;
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::BasicTrie()
+	: arena_{ emptyArena() }, root_{ ROOT }, frozenNodes_{ 0 },
+	freeNodes_{ ROOT }, size_{ 0 }, wordsRemoved_{ 0 }
+{
+	// the arena comes with the first insert
+	std::fill(freeBlocks_, freeBlocks_ + DIRECT + 1, NOBLOCK);
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::BasicTrie(const BasicTrie& other)
+	: arena_{ (other.arena_ == emptyArena()) ? other.arena_ : std::make_shared<Arena>(*other.arena_) }, root_{ other.root_ },
+	frozenNodes_{ other.frozenNodes_ }, freeNodes_{ other.freeNodes_ }, size_{ other.size_ }, wordsRemoved_{ other.wordsRemoved_ }
+{
+	// the arena is copied so nothing is shared with other. the empty
+	//  arena is never written, so it is shared anyway
+	std::copy(other.freeBlocks_, other.freeBlocks_ + DIRECT + 1, freeBlocks_);
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet>& BasicTrie<Alphabet>::operator=(const BasicTrie& other)
+{
+	if (this != &other) {
+		BasicTrie copy(other);
+		*this = std::move(copy);
+	}
+	return *this;
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::BasicTrie(BasicTrie&& other) noexcept
+	: arena_{ std::move(other.arena_) }, root_{ other.root_ }, frozenNodes_{ other.frozenNodes_ },
+	freeNodes_{ other.freeNodes_ }, size_{ other.size_ }, wordsRemoved_{ other.wordsRemoved_ }
+{
+	std::copy(other.freeBlocks_, other.freeBlocks_ + DIRECT + 1, freeBlocks_);
+	// other is left empty so it can still be used
+	other.removeAll();
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet>& BasicTrie<Alphabet>::operator=(BasicTrie&& other) noexcept
+{
+	if (this != &other) {
+		arena_ = std::move(other.arena_);
+		root_ = other.root_;
+		frozenNodes_ = other.frozenNodes_;
+		freeNodes_ = other.freeNodes_;
+		std::copy(other.freeBlocks_, other.freeBlocks_ + DIRECT + 1, freeBlocks_);
+		size_ = other.size_;
+		wordsRemoved_ = other.wordsRemoved_;
+		other.removeAll();
+	}
+	return *this;
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet> BasicTrie<Alphabet>::clone()
+{
+	// nodes made so far are shared from now on, and their blocks with them. free slots
+	//  are dropped so the two tries never hand out the same one
+	frozenNodes_ = static_cast<NodeIndex>(arena_->nodes_.size());
+	freeNodes_ = ROOT;
+	std::fill(freeBlocks_, freeBlocks_ + DIRECT + 1, NOBLOCK);
+
+	// the copy points at the same arena and root
+	BasicTrie copy = BasicTrie();
+	copy.arena_ = arena_;
+	copy.root_ = root_;
+	copy.frozenNodes_ = frozenNodes_;
+	copy.size_ = size_;
+	copy.wordsRemoved_ = wordsRemoved_;
+	return copy;
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::insert(std::string_view word)
+{
+	// check every char before anything changes
+	if (!inAlphabet(word)) {
+		throw std::invalid_argument("Trie can not hold a char outside of its alphabet");
+	}
+
+	if (word.size() != 0) {
+		if (frozenNodes_ != 0 && subTrieExists(root_, word)) {
+			// nothing changes. dont copy a shared path for nothing
+			return;
+		}
+
+		// insert word into the root
+		ownArena();
+		root_ = ownNode(root_);
+		subTrieInsert(root_, word);
+	}
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::subTrieInsert(NodeIndex subNode, std::string_view word)
+{
+	// walk down the word, adding the chars that are missing
+	for (size_t key = 0; key != word.size() * Alphabet::STEPS; ++key) {
+		unsigned char c = keyAt(word, key);
+		NodeIndex found = findChild(subNode, c);
+		subNode = (found != ROOT) ? ownChild(subNode, c, found) : addChild(subNode, c);
+	}
+
+	if (!arena_->nodes_[subNode].endOfString_) {
+		// last char was not end of word. so we mark it as so
+		//  and increment size
+		arena_->nodes_[subNode].endOfString_ = true;
+		++size_;
+	}
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::exists(std::string_view word) const
+{
+	// look for word in trie. a char outside of the alphabet is never there
+	return (word.size() != 0 && inAlphabet(word) && subTrieExists(root_, word));
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::subTrieExists(NodeIndex subNode, std::string_view word) const
+{
+	// need the last char to be there, and be the end of a word
+	NodeIndex found = descend(subNode, word);
+	return ((found != ROOT) && (arena_->nodes_[found].endOfString_));
+}
+
+template <typename Alphabet>
+std::vector<std::string> BasicTrie<Alphabet>::restOfString(std::string_view prefix) const
+{
+	// find rest of word
+	std::vector<std::string> output = std::vector<std::string>();
+	restOfString(prefix, std::back_inserter(output));
+	return output;
+}
+
+template <typename Alphabet>
+template <typename OutputIt>
+OutputIt BasicTrie<Alphabet>::restOfString(std::string_view prefix, OutputIt out) const
+{
+	forEachCompletion(prefix, [&](std::string word) {
+		*out = std::move(word);
+		++out;
+	});
+	return out;
+}
+
+template <typename Alphabet>
+template <typename Callback>
+void BasicTrie<Alphabet>::forEachCompletion(std::string_view prefix, Callback callback) const
+{
+	if (!inAlphabet(prefix)) {
+		// char not in alphabet... no suggestions
+		return;
+	}
+
+	NodeIndex found = descend(root_, prefix);
+	if (found == ROOT && prefix.size() != 0) {
+		// character not in trie... no suggestions
+		return;
+	}
+
+	// the keys of prefix start every word below found
+	std::string currWord;
+	currWord.reserve(prefix.size() * Alphabet::STEPS);
+	for (size_t key = 0; key != prefix.size() * Alphabet::STEPS; ++key) {
+		currWord.push_back(static_cast<char>(keyAt(prefix, key)));
+	}
+
+	// children are visited in order so words come out in order. the
+	//  depth of a node tells how much of currWord is still its path
+	size_t start = currWord.size();
+	walkSubTrie(found, [&](unsigned char key, NodeIndex child, size_t depth) {
+		currWord.resize(start + depth - 1);
+		currWord.push_back(static_cast<char>(key));
+		if (arena_->nodes_[child].endOfString_) {
+			callback(toWord(currWord));
+		}
+		return true;
+	}, [](NodeIndex&, size_t, unsigned char*, NodeIndex*, size_t) {});
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::Completions BasicTrie<Alphabet>::completions(std::string_view prefix) const
+{
+	return Completions(*this, prefix);
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::remove(std::string_view word)
+{
+	if (word.size() == 0 || !inAlphabet(word) || arena_ == emptyArena()) {
+		// the empty arena holds no words
+		return false;
+	}
+	if (frozenNodes_ != 0 && !subTrieExists(root_, word)) {
+		// nothing changes. dont copy a shared path for nothing
+		return false;
+	}
+	root_ = ownNode(root_);
+	return unmarkEndOfString(root_, word);
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::removeAll() noexcept
+{
+	// back to the empty arena. clones keep theirs
+	arena_ = emptyArena();
+	root_ = ROOT;
+	frozenNodes_ = 0;
+	freeNodes_ = ROOT;
+	std::fill(freeBlocks_, freeBlocks_ + DIRECT + 1, NOBLOCK);
+	size_ = 0;
+	wordsRemoved_ = 0;
+}
+
+template <typename Alphabet>
+const std::shared_ptr<typename BasicTrie<Alphabet>::Arena>& BasicTrie<Alphabet>::emptyArena()
+{
+	// made by the first trie, before anything can be moved
+	static const std::shared_ptr<Arena> empty = std::make_shared<Arena>(Arena{ std::vector<Node>(1, Node()),
+		std::vector<NodeIndex>() });
+	return empty;
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::ownArena()
+{
+	if (arena_ == emptyArena()) {
+		// nothing to keep from the empty arena but its root
+		arena_ = std::make_shared<Arena>(*emptyArena());
+		root_ = ROOT;
+		frozenNodes_ = 0;
+		freeNodes_ = ROOT;
+		std::fill(freeBlocks_, freeBlocks_ + DIRECT + 1, NOBLOCK);
+	}
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::unmarkEndOfString(NodeIndex subNode, std::string_view word)
+{
+	// walk down the word. a shared trie only gets here if word is in it,
+	//  so copying the path on the way down is never for nothing
+	for (size_t key = 0; key != word.size() * Alphabet::STEPS; ++key) {
+		unsigned char c = keyAt(word, key);
+		NodeIndex found = findChild(subNode, c);
+		if (found == ROOT) {
+			// character not in trie. means word does not exist in trie
+			return false;
+		}
+		subNode = ownChild(subNode, c, found);
+	}
+
+	// check if it is the last char in a word
+	if (!arena_->nodes_[subNode].endOfString_) {
+		// didnt unmark end of word... return false
+		return false;
+	}
+
+	// umark as end of word. decrease size
+	arena_->nodes_[subNode].endOfString_ = false;
+	--size_;
+	++wordsRemoved_;
+
+	// check if we need to remove unused nodes
+	if (wordsRemoved_ == MAXWORDSREMOVED) {
+		removeUnusedNodes(root_); // removing unused nodes
+		wordsRemoved_ = 0;
+	}
+
+	// finished unmarking end of word
+	return true;
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::removeUnusedNodes(NodeIndex& subNode)
+{
+	// children are done before their parent. a child that leads to no word
+	//  comes back as ROOT, and a shared child that changed as its copy
+	bool keep = true;
+	subNode = walkSubTrie(subNode, [](unsigned char, NodeIndex, size_t) {
+		return true;
+	}, [&](NodeIndex& node, size_t depth, unsigned char* keys, NodeIndex* children, size_t count) {
+		// node itself is untouched so far. compare to see if a child was copied
+		bool copied = false;
+		size_t i = 0;
+		forEachChild(node, [&](unsigned char, NodeIndex child) {
+			copied = copied || (children[i] != child && children[i] != ROOT);
+			++i;
+		});
+
+		// children that are kept get moved to the front so they stay sorted
+		size_t kept = 0;
+		for (i = 0; i != count; ++i) {
+			if (children[i] != ROOT) {
+				keys[kept] = keys[i];
+				children[kept] = children[i];
+				++kept;
+			}
+		}
+
+		if (kept != count || copied) {
+			// lost children. move the rest into the smallest kind that holds them
+			node = ownNode(node);
+			setChildren(node, keys, children, kept, kindFor(kept));
+		}
+
+		// contains either an end of word... or a child does
+		//  so we keep this node
+		keep = (kept != 0);
+		if (depth != 0 && !keep && !arena_->nodes_[node].endOfString_) {
+			if (node >= frozenNodes_) {
+				// lost all of its children already. give its slot back
+				arena_->nodes_[node].slots_[0] = freeNodes_;
+				freeNodes_ = node;
+			}
+			node = ROOT;
+		}
+	});
+
+	// return whether we should keep nodes or not
+	return keep;
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::countAllNodes(NodeIndex subNode) const
+{
+	// every node below subNode is entered once
+	size_t count = 0;
+	walkSubTrie(subNode, [&](unsigned char, NodeIndex, size_t) {
+		++count;
+		return true;
+	}, [](NodeIndex&, size_t, unsigned char*, NodeIndex*, size_t) {});
+	return count;
+}
+
+template <typename Alphabet>
+std::vector<bool> BasicTrie<Alphabet>::usedNodes(NodeIndex subNode) const
+{
+	// children are done before their parent, so their flags are known
+	std::vector<bool> used(arena_->nodes_.size(), false);
+	walkSubTrie(subNode, [](unsigned char, NodeIndex, size_t) {
+		return true;
+	}, [&](NodeIndex& node, size_t, unsigned char*, NodeIndex* children, size_t count) {
+		bool leadsToWord = arena_->nodes_[node].endOfString_;
+		for (size_t i = 0; !leadsToWord && i != count; ++i) {
+			leadsToWord = used[children[i]];
+		}
+		used[node] = leadsToWord;
+	});
+	return used;
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::isEndOfString(NodeIndex subNode) const
+{
+	return arena_->nodes_[subNode].endOfString_;
+}
+
+template <typename Alphabet>
+template <typename Enter, typename Leave>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::walkSubTrie(NodeIndex subNode,
+	Enter enter, Leave leave) const
+{
+	// one frame per node on the path down from subNode. the children of
+	//  every frame are copied onto one shared stack, so the arena can
+	//  change under the walk and leave can rewrite a child in place
+	struct Frame {
+		size_t first_; // first child of the node in keys and children
+		size_t next_; // next child to enter
+	};
+	std::vector<Frame> frames;
+	std::vector<unsigned char> keys;
+	std::vector<NodeIndex> children;
+
+	// room for most walks up front, so they grow once if at all
+	frames.reserve(64);
+	keys.reserve(256);
+	children.reserve(256);
+	auto push = [&](NodeIndex node) {
+		frames.push_back(Frame{ children.size(), children.size() });
+		forEachChild(node, [&](unsigned char key, NodeIndex child) {
+			keys.push_back(key);
+			children.push_back(child);
+		});
+	};
+
+	push(subNode);
+	while (!frames.empty()) {
+		// children of the top frame are always last on the stack
+		Frame& top = frames.back();
+		if (top.next_ != children.size()) {
+			size_t i = top.next_;
+			++top.next_;
+			if (enter(keys[i], children[i], frames.size())) {
+				push(children[i]);
+			}
+			continue;
+		}
+
+		// every child is done. the node is in its parent's children
+		size_t depth = frames.size() - 1;
+		NodeIndex& node = (depth == 0) ? subNode : children[frames[depth - 1].next_ - 1];
+		leave(node, depth, keys.data() + top.first_, children.data() + top.first_,
+			children.size() - top.first_);
+		keys.resize(top.first_);
+		children.resize(top.first_);
+		frames.pop_back();
+	}
+	return subNode;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::descend(NodeIndex subNode,
+	std::string_view word) const
+{
+	for (size_t key = 0; key != word.size() * Alphabet::STEPS; ++key) {
+		subNode = findChild(subNode, keyAt(word, key));
+		if (subNode == ROOT) {
+			// character not in trie
+			return ROOT;
+		}
+	}
+	return subNode;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::chainEnd(NodeIndex subNode) const
+{
+	while (arena_->nodes_[subNode].childCount_ == 1) {
+		forEachChild(subNode, [&](unsigned char, NodeIndex child) {
+			subNode = child;
+		});
+	}
+	return subNode;
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::height(NodeIndex subNode) const
+{
+	// children are done before their parent, so the levels of its
+	//  children are the last ones on the stack
+	std::vector<size_t> levels;
+	walkSubTrie(subNode, [](unsigned char, NodeIndex, size_t) {
+		return true;
+	}, [&](NodeIndex&, size_t, unsigned char*, NodeIndex*, size_t count) {
+		size_t most = 0;
+		for (size_t i = levels.size() - count; i != levels.size(); ++i) {
+			most = std::max(most, levels[i]);
+		}
+		levels.resize(levels.size() - count);
+
+		// an only child is the same level as its parent
+		levels.push_back((count == 1) ? most : most + 1);
+	});
+	return levels.back();
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::vebOrder(NodeIndex subNode, size_t levels, std::vector<NodeIndex>& order,
+	std::vector<NodeIndex>& below) const
+{
+	// base case is a single level. its chain of only children goes with it
+	if (levels == 1) {
+		order.push_back(subNode);
+		while (arena_->nodes_[subNode].childCount_ == 1) {
+			forEachChild(subNode, [&](unsigned char, NodeIndex child) {
+				subNode = child;
+			});
+			order.push_back(subNode);
+		}
+		forEachChild(subNode, [&](unsigned char, NodeIndex child) {
+			below.push_back(child);
+		});
+		return;
+	}
+
+	// top half first, then every subtree hanging off of it
+	size_t top = levels / 2;
+	std::vector<NodeIndex> middle;
+	vebOrder(subNode, top, order, middle);
+	for (auto i = middle.begin(); i != middle.end(); ++i) {
+		vebOrder(*i, levels - top, order, below);
+	}
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::findChild(NodeIndex subNode, unsigned char key) const
+{
+	const Node& node = arena_->nodes_[subNode];
+	const NodeIndex* block = arena_->blocks_.data() + ((node.kind_ > INLINE) ? node.slots_[0] : 0);
+	const unsigned char* keys = (node.kind_ == INLINE) ? node.keys_ : reinterpret_cast<const unsigned char*>(block);
+	const NodeIndex* children = (node.kind_ == INLINE) ? node.slots_ : block + KEYWORDS[node.kind_];
+
+	switch (node.kind_) {
+	case NODE16:
+#ifdef TRIE_SSE2
+	{
+		// compare all 16 keys at once. bits past childCount_ are ignored
+		__m128i all = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys));
+		unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(_mm_cmpeq_epi8(all, _mm_set1_epi8(static_cast<char>(key)))));
+		mask &= (1u << node.childCount_) - 1;
+		return (mask != 0) ? children[lowestBit64(mask)] : ROOT;
+	}
+#endif
+	case INLINE:
+	case NODE4:
+		// few keys. a scan is cheapest
+		for (size_t i = 0; i != node.childCount_; ++i) {
+			if (keys[i] == key) {
+				return children[i];
+			}
+		}
+		return ROOT;
+	case BITMAP48:
+		// bit test, then the rank of the bit is the slot
+		if (((block[key / 32] >> (key % 32)) & 1) == 0) {
+			return ROOT;
+		}
+		return children[bitmapRank(block, key)];
+	case DIRECT:
+		// empty slots hold ROOT
+		return children[key];
+	default:
+		// no children
+		return ROOT;
+	}
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::addChild(NodeIndex subNode, unsigned char key)
+{
+	// create the child first since it can move nodes_
+	NodeIndex child = newNode();
+
+	if (arena_->nodes_[subNode].childCount_ == CAPACITY[arena_->nodes_[subNode].kind_]) {
+		// block is full. grow it into the next kind
+		unsigned char keys[256];
+		NodeIndex children[256];
+		size_t count = 0;
+		forEachChild(subNode, [&](unsigned char childKey, NodeIndex grandChild) {
+			keys[count] = childKey;
+			children[count] = grandChild;
+			++count;
+		});
+		setChildren(subNode, keys, children, count, nextKind(arena_->nodes_[subNode].kind_));
+	}
+
+	Node& node = arena_->nodes_[subNode];
+	NodeIndex* block = arena_->blocks_.data() + ((node.kind_ > INLINE) ? node.slots_[0] : 0);
+	unsigned char* keys = (node.kind_ == INLINE) ? node.keys_ : reinterpret_cast<unsigned char*>(block);
+	NodeIndex* children = (node.kind_ == INLINE) ? node.slots_ : block + KEYWORDS[node.kind_];
+
+	switch (node.kind_) {
+	case INLINE:
+	case NODE4:
+	case NODE16:
+	{
+		// shift bigger keys over by one and put the child in its place
+		size_t i = node.childCount_;
+		while (i != 0 && keys[i - 1] > key) {
+			keys[i] = keys[i - 1];
+			children[i] = children[i - 1];
+			--i;
+		}
+		keys[i] = key;
+		children[i] = child;
+		break;
+	}
+	case BITMAP48:
+	{
+		// children stay in key order. open up the slot of the new one
+		size_t rank = bitmapRank(block, key);
+		std::copy_backward(children + rank, children + node.childCount_, children + node.childCount_ + 1);
+		children[rank] = child;
+		block[key / 32] |= uint32_t(1) << (key % 32);
+		break;
+	}
+	default:
+		children[key] = child;
+		break;
+	}
+	++node.childCount_;
+
+	return child;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::ownNode(NodeIndex subNode)
+{
+	if (subNode >= frozenNodes_) {
+		// not shared. nodes made since the last clone own their blocks too
+		return subNode;
+	}
+
+	// copy the node out first since newNode and allocateBlock can move the arena
+	Node node = arena_->nodes_[subNode];
+	NodeIndex copy = newNode();
+	if (node.kind_ > INLINE) {
+		uint32_t block = allocateBlock(node.kind_);
+		std::copy(arena_->blocks_.begin() + node.slots_[0],
+			arena_->blocks_.begin() + node.slots_[0] + KEYWORDS[node.kind_] + CAPACITY[node.kind_],
+			arena_->blocks_.begin() + block);
+		node.slots_[0] = block;
+	}
+	arena_->nodes_[copy] = node;
+	return copy;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::ownChild(NodeIndex subNode, unsigned char key, NodeIndex child)
+{
+	NodeIndex copy = ownNode(child);
+	if (copy == child) {
+		return child;
+	}
+
+	// point the parent at the copy
+	Node& node = arena_->nodes_[subNode];
+	NodeIndex* block = arena_->blocks_.data() + ((node.kind_ > INLINE) ? node.slots_[0] : 0);
+	unsigned char* keys = (node.kind_ == INLINE) ? node.keys_ : reinterpret_cast<unsigned char*>(block);
+	NodeIndex* children = (node.kind_ == INLINE) ? node.slots_ : block + KEYWORDS[node.kind_];
+
+	switch (node.kind_) {
+	case INLINE:
+	case NODE4:
+	case NODE16:
+		for (size_t i = 0; i != node.childCount_; ++i) {
+			if (keys[i] == key) {
+				children[i] = copy;
+			}
+		}
+		break;
+	case BITMAP48:
+		children[bitmapRank(block, key)] = copy;
+		break;
+	default:
+		children[key] = copy;
+		break;
+	}
+	return copy;
+}
+
+template <typename Alphabet>
+template <typename Visitor>
+void BasicTrie<Alphabet>::forEachChild(NodeIndex subNode, Visitor visit) const
+{
+	const Node& node = arena_->nodes_[subNode];
+	const NodeIndex* block = arena_->blocks_.data() + ((node.kind_ > INLINE) ? node.slots_[0] : 0);
+	const unsigned char* keys = (node.kind_ == INLINE) ? node.keys_ : reinterpret_cast<const unsigned char*>(block);
+	const NodeIndex* children = (node.kind_ == INLINE) ? node.slots_ : block + KEYWORDS[node.kind_];
+
+	switch (node.kind_) {
+	case INLINE:
+	case NODE4:
+	case NODE16:
+		// keys are sorted
+		for (size_t i = 0; i != node.childCount_; ++i) {
+			visit(keys[i], children[i]);
+		}
+		break;
+	case BITMAP48:
+	{
+		// set bits come out in key order, same as the children
+		size_t slot = 0;
+		for (size_t word = 0; word != 4; ++word) {
+			uint64_t bits = bitmapWord(block, word);
+			while (bits != 0) {
+				visit(static_cast<unsigned char>(word * 64 + lowestBit64(bits)), children[slot]);
+				++slot;
+				bits &= bits - 1;
+			}
+		}
+		break;
+	}
+	case DIRECT:
+		for (size_t key = 0; key != Alphabet::SIZE; ++key) {
+			if (children[key] != ROOT) {
+				visit(static_cast<unsigned char>(key), children[key]);
+			}
+		}
+		break;
+	default:
+		// no children
+		break;
+	}
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::setChildren(NodeIndex subNode, const unsigned char* keys,
+	const NodeIndex* children, size_t count, Kind kind)
+{
+	if (kind != arena_->nodes_[subNode].kind_) {
+		// swap the block for a zeroed one of the new kind. nodes with
+		//  few children keep them inline and need no block
+		releaseBlock(arena_->nodes_[subNode].slots_[0], arena_->nodes_[subNode].kind_);
+		uint32_t block = (kind > INLINE) ? allocateBlock(kind) : 0;
+		arena_->nodes_[subNode].kind_ = kind;
+		arena_->nodes_[subNode].slots_[0] = block;
+	}
+	else if (kind > INLINE) {
+		// reuse the block. clear it since the bitmap and 256 look for empty slots
+		std::fill(arena_->blocks_.begin() + arena_->nodes_[subNode].slots_[0],
+			arena_->blocks_.begin() + arena_->nodes_[subNode].slots_[0] + KEYWORDS[kind] + CAPACITY[kind], ROOT);
+	}
+	Node& node = arena_->nodes_[subNode];
+	node.childCount_ = static_cast<uint16_t>(count);
+
+	NodeIndex* block = arena_->blocks_.data() + ((kind > INLINE) ? node.slots_[0] : 0);
+	unsigned char* blockKeys = (kind == INLINE) ? node.keys_ : reinterpret_cast<unsigned char*>(block);
+	NodeIndex* blockChildren = (kind == INLINE) ? node.slots_ : block + KEYWORDS[kind];
+	for (size_t i = 0; i != count; ++i) {
+		switch (kind) {
+		case INLINE:
+		case NODE4:
+		case NODE16:
+			blockKeys[i] = keys[i];
+			blockChildren[i] = children[i];
+			break;
+		case BITMAP48:
+			// keys are sorted so children are already in rank order
+			block[keys[i] / 32] |= uint32_t(1) << (keys[i] % 32);
+			blockChildren[i] = children[i];
+			break;
+		default:
+			blockChildren[keys[i]] = children[i];
+			break;
+		}
+	}
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::newNode()
+{
+	if (freeNodes_ == ROOT) {
+		// no free slots. grow the arena while indices stay below UNSEEN
+		if (arena_->nodes_.size() >= UNSEEN) {
+			throw std::length_error("Trie has more nodes than a NodeIndex can address");
+		}
+		arena_->nodes_.push_back(Node());
+		return static_cast<NodeIndex>(arena_->nodes_.size() - 1);
+	}
+
+	// take the first free slot
+	NodeIndex slot = freeNodes_;
+	freeNodes_ = arena_->nodes_[slot].slots_[0];
+	arena_->nodes_[slot] = Node();
+	return slot;
+}
+
+template <typename Alphabet>
+uint32_t BasicTrie<Alphabet>::allocateBlock(Kind kind)
+{
+	size_t words = KEYWORDS[kind] + CAPACITY[kind];
+	uint32_t block = freeBlocks_[kind];
+	if (block == NOBLOCK) {
+		// no free block of this kind. grow the arena while offsets still
+		//  fit below NOBLOCK
+		if (arena_->blocks_.size() + words > NOBLOCK) {
+			throw std::length_error("Trie child blocks no longer fit in 32-bit offsets");
+		}
+		block = static_cast<uint32_t>(arena_->blocks_.size());
+		arena_->blocks_.resize(arena_->blocks_.size() + words, ROOT);
+		return block;
+	}
+
+	// take the first free block and clear it
+	freeBlocks_[kind] = arena_->blocks_[block];
+	std::fill(arena_->blocks_.begin() + block, arena_->blocks_.begin() + block + words, ROOT);
+	return block;
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::releaseBlock(uint32_t block, Kind kind)
+{
+	if (kind > INLINE) {
+		arena_->blocks_[block] = freeBlocks_[kind];
+		freeBlocks_[kind] = block;
+	}
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::inAlphabet(std::string_view word)
+{
+	for (auto i = word.begin(); i != word.end(); ++i) {
+		for (size_t step = 0; step != Alphabet::STEPS; ++step) {
+			if (Alphabet::index(*i, step) >= Alphabet::SIZE) {
+				// char not in the alphabet
+				return false;
+			}
+		}
+	}
+	return true;
+}
+
+template <typename Alphabet>
+unsigned char BasicTrie<Alphabet>::keyAt(std::string_view word, size_t key)
+{
+	return static_cast<unsigned char>(Alphabet::index(word[key / Alphabet::STEPS], key % Alphabet::STEPS));
+}
+
+template <typename Alphabet>
+std::string BasicTrie<Alphabet>::toWord(const std::string& keys)
+{
+	std::string word;
+	word.reserve(keys.size() / Alphabet::STEPS);
+	for (size_t i = 0; i + Alphabet::STEPS <= keys.size(); i += Alphabet::STEPS) {
+		char c = 0;
+		for (size_t step = 0; step != Alphabet::STEPS; ++step) {
+			c = Alphabet::symbol(c, step, static_cast<unsigned char>(keys[i + step]));
+		}
+		word.push_back(c);
+	}
+	return word;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::Kind BasicTrie<Alphabet>::kindFor(size_t count)
+{
+	Kind kind = EMPTY;
+	while (CAPACITY[kind] < count) {
+		kind = nextKind(kind);
+	}
+	return kind;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::Kind BasicTrie<Alphabet>::nextKind(Kind kind)
+{
+	// a kind that holds as many children as DIRECT is never smaller, and
+	//  one that holds no more than kind is no help
+	Kind next = static_cast<Kind>(kind + 1);
+	while (next != DIRECT && (CAPACITY[next] >= Alphabet::SIZE || CAPACITY[next] <= CAPACITY[kind])) {
+		next = static_cast<Kind>(next + 1);
+	}
+	return next;
+}
+
+template <typename Alphabet>
+uint64_t BasicTrie<Alphabet>::bitmapWord(const uint32_t* bitmap, size_t word)
+{
+	return uint64_t(bitmap[2 * word]) | (uint64_t(bitmap[2 * word + 1]) << 32);
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::bitmapRank(const uint32_t* bitmap, size_t key)
+{
+	size_t rank = 0;
+	for (size_t word = 0; word != key / 64; ++word) {
+		rank += popcount64(bitmapWord(bitmap, word));
+	}
+	return rank + popcount64(bitmapWord(bitmap, key / 64) & ((uint64_t(1) << (key % 64)) - 1));
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::size() const
+{
+	return size_;
+}
+
+template <typename Alphabet>
+bool BasicTrie<Alphabet>::empty() const
+{
+	return size_ == 0;
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::totalNodes() const
+{
+	return countAllNodes(root_);
+}
+
+template <typename Alphabet>
+std::ostream& BasicTrie<Alphabet>::showStatistics(std::ostream& out) const
+{
+	out << "Words contained: " << size_;
+	out << ", Total nodes: " << totalNodes();
+	out << ", Words left till removing unused nodes: " << (MAXWORDSREMOVED - wordsRemoved_);
+	out << std::endl;
+	return out;
+}
+
+template <typename Alphabet>
+std::ostream& BasicTrie<Alphabet>::print(std::ostream& out) const
+{
+	// find all the words inside the trie
+	forEachCompletion("", [&](const std::string& word) {
+		out << word << ' ';
+	});
+	out << std::endl;
+	return out;
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::relayout()
+{
+	// nodes that lead to no word are not worth a place
+	removeUnusedNodes(root_);
+	wordsRemoved_ = 0;
+
+	// every node stands for itself
+	std::vector<NodeIndex> canonical(arena_->nodes_.size());
+	for (size_t i = 0; i != canonical.size(); ++i) {
+		canonical[i] = static_cast<NodeIndex>(i);
+	}
+	rebuild(canonical);
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::deduplicate()
+{
+	// nodes that lead to no word would only hide equal subtrees
+	removeUnusedNodes(root_);
+	wordsRemoved_ = 0;
+
+	// bottom up, each subtree maps to the first one with the same shape
+	std::vector<NodeIndex> canonical(arena_->nodes_.size(), UNSEEN);
+	std::unordered_map<std::string, NodeIndex> shapes;
+	canonicalNode(root_, canonical, shapes);
+	rebuild(canonical);
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::NodeIndex BasicTrie<Alphabet>::canonicalNode(NodeIndex subNode,
+	std::vector<NodeIndex>& canonical, std::unordered_map<std::string, NodeIndex>& shapes) const
+{
+	// children are done before their parent. a node that is shared is
+	//  done already the second time it is reached
+	walkSubTrie(subNode, [&](unsigned char, NodeIndex child, size_t) {
+		return canonical[child] == UNSEEN;
+	}, [&](NodeIndex& node, size_t, unsigned char* keys, NodeIndex* children, size_t count) {
+		// a shape is the end of word mark, then the key and canonical child of
+		//  every child. equal shapes mean equal subtrees
+		std::string shape(1, arena_->nodes_[node].endOfString_ ? '\1' : '\0');
+		for (size_t i = 0; i != count; ++i) {
+			NodeIndex same = canonical[children[i]];
+			shape.push_back(static_cast<char>(keys[i]));
+			shape.append(reinterpret_cast<const char*>(&same), sizeof(NodeIndex));
+		}
+		canonical[node] = shapes.emplace(shape, node).first->second;
+	});
+	return canonical[subNode];
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::rebuild(const std::vector<NodeIndex>& canonical)
+{
+	std::vector<NodeIndex> order;
+	std::vector<NodeIndex> below;
+	order.reserve(arena_->nodes_.size());
+	vebOrder(root_, height(root_), order, below);
+
+	// new index of every canonical node, placed where it is first reached.
+	//  the root comes first so it lands on ROOT
+	std::vector<NodeIndex> position(arena_->nodes_.size(), UNSEEN);
+	size_t placed = 0;
+	for (auto i = order.begin(); i != order.end(); ++i) {
+		NodeIndex same = canonical[*i];
+		if (position[same] == UNSEEN) {
+			position[same] = static_cast<NodeIndex>(placed);
+			order[placed] = same;
+			++placed;
+		}
+	}
+	bool shared = (placed != order.size());
+	order.resize(placed);
+
+	// copy nodes and blocks over in that order. the old arena stays with
+	//  any clones
+	std::shared_ptr<Arena> arena = std::make_shared<Arena>();
+	arena->nodes_.reserve(order.size());
+	for (auto i = order.begin(); i != order.end(); ++i) {
+		Node node = arena_->nodes_[*i];
+		NodeIndex* children = node.slots_;
+		if (node.kind_ > INLINE) {
+			// blocks go in the same order as their nodes
+			const NodeIndex* block = arena_->blocks_.data() + node.slots_[0];
+			node.slots_[0] = static_cast<uint32_t>(arena->blocks_.size());
+			arena->blocks_.insert(arena->blocks_.end(), block, block + KEYWORDS[node.kind_] + CAPACITY[node.kind_]);
+			children = arena->blocks_.data() + node.slots_[0] + KEYWORDS[node.kind_];
+		}
+
+		// point the children at their new places. DIRECT has holes
+		size_t slots = (node.kind_ == DIRECT) ? CAPACITY[DIRECT] : node.childCount_;
+		for (size_t slot = 0; slot != slots; ++slot) {
+			if (children[slot] != ROOT) {
+				children[slot] = position[canonical[children[slot]]];
+			}
+		}
+		arena->nodes_.push_back(node);
+	}
+
+	// nodes with several parents must never change in place. freezing
+	//  them all makes insert and remove copy the path they change
+	arena_ = arena;
+	root_ = ROOT;
+	frozenNodes_ = shared ? static_cast<NodeIndex>(arena_->nodes_.size()) : 0;
+	freeNodes_ = ROOT;
+	std::fill(freeBlocks_, freeBlocks_ + DIRECT + 1, NOBLOCK);
+}
+
+template <typename Alphabet>
+size_t BasicTrie<Alphabet>::memoryUsage() const
+{
+	// clones count the arena they share each time
+	return sizeof(BasicTrie) + arena_->nodes_.capacity() * sizeof(Node) + arena_->blocks_.capacity() * sizeof(NodeIndex);
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Node Implementation /////////////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::Node::Node()
+	: endOfString_{ false }, kind_{ EMPTY }, childCount_{ 0 }, keys_{}, slots_{}
+{
+	// nothing to do here
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Completions Implementation //////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::Completions::Completions(const BasicTrie& trie, std::string_view prefix)
+	: trie_{ &trie }, prefix_{ prefix }
+{
+	// nothing to do here
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionIterator BasicTrie<Alphabet>::Completions::begin() const
+{
+	CompletionIterator i = CompletionIterator();
+	if (!inAlphabet(prefix_)) {
+		// char not in alphabet... no suggestions
+		return i;
+	}
+	NodeIndex found = trie_->descend(trie_->root_, prefix_);
+	if (found == ROOT && prefix_.size() != 0) {
+		// character not in trie... no suggestions
+		return i;
+	}
+
+	// the keys of prefix start every word below found
+	for (size_t key = 0; key != prefix_.size() * Alphabet::STEPS; ++key) {
+		i.keys_.push_back(static_cast<char>(keyAt(prefix_, key)));
+	}
+	i.start_ = i.keys_.size();
+	i.trie_ = trie_;
+	trie_->forEachChild(found, [&](unsigned char key, NodeIndex child) {
+		i.pending_.push_back(typename CompletionIterator::Pending{ child, key, 1 });
+	});
+	std::reverse(i.pending_.begin(), i.pending_.end());
+	i.advance();
+	return i;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionSentinel BasicTrie<Alphabet>::Completions::end() const
+{
+	return CompletionSentinel();
+}
+
+template <typename Alphabet>
+BasicTrie<Alphabet>::CompletionIterator::CompletionIterator()
+	: trie_{ nullptr }, start_{ 0 }
+{
+	// nothing to do here
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionIterator::reference BasicTrie<Alphabet>::CompletionIterator::operator*() const
+{
+	return word_;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionIterator::pointer BasicTrie<Alphabet>::CompletionIterator::operator->() const
+{
+	return &word_;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionIterator& BasicTrie<Alphabet>::CompletionIterator::operator++()
+{
+	advance();
+	return *this;
+}
+
+template <typename Alphabet>
+typename BasicTrie<Alphabet>::CompletionIterator BasicTrie<Alphabet>::CompletionIterator::operator++(int)
+{
+	CompletionIterator old = *this;
+	advance();
+	return old;
+}
+
+template <typename Alphabet>
+void BasicTrie<Alphabet>::CompletionIterator::advance()
+{
+	while (!pending_.empty()) {
+		Pending next = pending_.back();
+		pending_.pop_back();
+		keys_.resize(start_ + next.depth_ - 1);
+		keys_.push_back(static_cast<char>(next.key_));
+
+		// children go on backwards so the smallest comes off first
+		size_t first = pending_.size();
+		trie_->forEachChild(next.node_, [&](unsigned char key, NodeIndex child) {
+			pending_.push_back(Pending{ child, key, next.depth_ + 1 });
+		});
+		std::reverse(pending_.begin() + first, pending_.end());
+
+		if (trie_->arena_->nodes_[next.node_].endOfString_) {
+			// stop at the word
+			word_ = toWord(keys_);
+			return;
+		}
+	}
+
+	// no nodes left
+	trie_ = nullptr;
+}
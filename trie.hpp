@@ -3,7 +3,7 @@
 *
 * \author lhernandezcruz
 *
-* \brief Interface for Trie
+* \brief Interface for BasicTrie and Trie, the trie of any bytes
 *
 */
 
@@ -12,53 +12,146 @@
 #define TRIE_HPP_INCLUDED 1
 
 #include <string>
+#include <string_view>
 #include <vector>
-#include <unordered_map>
 #include <memory>
+#include <unordered_map>
 #include <iostream>
+#include <iterator>
+#include <cstddef>
+#include <cstdint>
+#include "alphabet.hpp"
 
 /// Amount of words to remove before actually removing unused nodes
 const size_t MAXWORDSREMOVED = 20; 
-class Trie {
+
+/// Amount of children a trie node keeps inside itself before it needs a
+///  child block. Most nodes have one child or none
+const size_t INLINECHILDREN = 2;
+
+/// Trie over the chars of an alphabet policy (see alphabet.hpp). Child
+///  blocks are keyed by the dense index of each char, so a small alphabet
+///  gets direct arrays of exactly SIZE children once a node is full enough
+template <typename Alphabet>
+class BasicTrie {
 private:
 	struct Node;
+	typedef uint32_t NodeIndex; // position of a node inside nodes_
 public:
+	class CompletionIterator;
+	class CompletionSentinel;
+	class Completions;
+
 	/**
 	* \brief Default Constructor to create an empty trie
 	*/
-	Trie();
+	BasicTrie();
+
+	/**
+	* \brief			Copy Constructor. Copies every node so nothing is
+	*					 shared with other
+	* \param  other		Trie being copied
+	*/
+	BasicTrie(const BasicTrie& other);
+
+	/**
+	* \brief			Assignment Operator. Copies every node of other
+	* \param  other		Trie being copied
+	* \return			This trie
+	*/
+	BasicTrie& operator=(const BasicTrie& other);
+
+	/**
+	* \brief			Move Constructor. Takes the nodes of other and
+	*					 leaves it an empty trie
+	* \param  other		Trie being moved
+	*/
+	BasicTrie(BasicTrie&& other) noexcept;
+
+	/**
+	* \brief			Move Assignment Operator. Takes the nodes of other
+	*					 and leaves it an empty trie
+	* \param  other		Trie being moved
+	* \return			This trie
+	*/
+	BasicTrie& operator=(BasicTrie&& other) noexcept;
+
+	/**
+	* \brief			Copy of the trie in constant time. Both tries share
+	*					 their nodes until one changes. A change copies only
+	*					 the nodes on the path to the word
+	* \return			Trie with the same words
+	* \note				Clones share storage. Use them from one thread
+	*/
+	BasicTrie clone();
 
 	/**
 	* \brief			Insert a string into the trie
 	* \param  word	    Inserted word
+	* \throws			std::invalid_argument if a char of word is not in
+	*					 the alphabet. The trie is left as it was
+	*					std::length_error if the nodes or child blocks no
+	*					 longer fit in 32-bit indices
 	*/
-	void insert(std::string word);
+	void insert(std::string_view word);
 
 	/**
 	* \brief			Check if a string exists in the trie
 	* \param  word	    Word being checked in the trie
 	* \return			true if word is in the trie. false otherwise
 	*/
-	bool exists(std::string word);
+	bool exists(std::string_view word) const;
 
 	/**
 	* \brief			Tries to guess the rest of the string
 	* \param  prefix    Prefix that is being searched
 	* \return			A vector with strings in which the input is a prefix
 	*/
-	std::vector<std::string> restOfString(std::string prefix);
+	std::vector<std::string> restOfString(std::string_view prefix) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	*		  out		Where the words are written, in order. Any output
+	*					 iterator of strings, such as a back_inserter
+	* \return			out past the last word written
+	*/
+	template <typename OutputIt>
+	OutputIt restOfString(std::string_view prefix, OutputIt out) const;
+
+	/**
+	* \brief			Visits every word that starts with a prefix
+	* \param  prefix    Prefix that is being searched. Not visited itself
+	*		  callback	Called once per word, in order, with a std::string
+	*					 rvalue it can keep or move from
+	* \note				Nothing is stored along the way, so it uses no more
+	*					 memory than the longest word below prefix
+	*/
+	template <typename Callback>
+	void forEachCompletion(std::string_view prefix, Callback callback) const;
+
+	/**
+	* \brief			Lazy range of the words that start with a prefix
+	* \param  prefix    Prefix that is being searched. Copied into the range
+	* \return			Range for range-for or std::views::take. Words come
+	*					 out in order, one at a time, as the range is walked
+	* \note				Stopping after k words costs about the nodes on the
+	*					 way to them, not the whole subtree. The trie must
+	*					 not change while the range is walked
+	*/
+	Completions completions(std::string_view prefix) const;
 
 	/**
 	* \brief			Remove a string from the trie
 	* \param  word      Word being removed
 	* \return			true if word is removed from trie. false otherwise
 	*/
-	bool remove(std::string word);
+	bool remove(std::string_view word);
 
 	/**
 	* \brief			Remove all strings from trie
 	*/
-	void removeAll();
+	void removeAll() noexcept;
 
 	/**
 	* \brief			Gives the size of the trie
@@ -97,13 +190,46 @@ public:
 	* \note				Contains endl at end
 	*/
 	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the trie object plus its node and child arenas
+	* \note				Counts reserved capacity, not only the nodes in use
+	*/
+	size_t memoryUsage() const;
+
+	/**
+	* \brief			Rewrites the nodes and child blocks in van Emde Boas
+	*					 order for a trie that is done changing. Each subtree
+	*					 half as tall as the trie is stored in one run, and so
+	*					 on down, so a walk from the root touches about
+	*					 O(log_B n) cache lines for any cache line size B.
+	*					 Height counts branching nodes, so chains of only
+	*					 children stay in one run
+	* \note				Also removes unused nodes and drops the free lists.
+	*					 The trie can still change afterwards, but new nodes
+	*					 go at the end
+	*/
+	void relayout();
+
+	/**
+	* \brief			Merges subtrees that hold the same words, so words
+	*					 that end the same way share their ending nodes.
+	*					 Subtrees are hashed bottom up by their end of word
+	*					 marks and already merged children
+	* \note				Also relayouts the trie. Merged nodes are shared, so
+	*					 insert and remove copy the nodes on the path they
+	*					 change, as they do for clones. totalNodes still counts
+	*					 a shared node once for every path to it
+	*/
+	void deduplicate();
 private:
 	/**
 	* \brief			Insert a string into the trie
 	* \param  subNode	Which node we are looking to insert word to
 	*         word	    Word being inserted
 	*/
-	void subTrieInsert(Node& subNode, std::string word);
+	void subTrieInsert(NodeIndex subNode, std::string_view word);
 
 	/**
 	* \brief			Insert a string into a subTrie
@@ -111,18 +237,7 @@ private:
 	*         word	    Word being inserted
 	* \return           true if word exists in subTrie
 	*/
-	bool subTrieExists(Node& subNode, std::string word);
-
-	/**
-	* \brief			Returns strings that contain the input string as a prefix
-	* \param  subNode	Which node we are looking to see if word can be completed
-	*         prefix	prefix being completed
-	*		  currWord  Current word being predicted
-	*		  output    A vector that contains predicted words 
-	* \return           A vector with predicted words
-	*/
-	std::vector<std::string> restOfString(const Node& subNode, std::string prefix
-									,std::string currWord, std::vector<std::string> output) const;
+	bool subTrieExists(NodeIndex subNode, std::string_view word) const;
 
 	/**
 	* \brief			Insert a string into a subTrie
@@ -130,24 +245,261 @@ private:
 	*         word	    Word being inserted
 	* \return           true if word was marked (it existed as a word)
 	*/
-	bool unmarkEndOfString(Node& subNode, std::string word);
+	bool unmarkEndOfString(NodeIndex subNode, std::string_view word);
 
 	/**
 	* \brief			Remove Nodes that are not part of words
 	* \param  subNode	Which node we are looking for unused words
+	*					 Comes back as a copy if it was shared and changed
 	* \return           true if we should keep the subNode
 	* \note				Will only delete unused nodes after a certain
 	*					 amount of times unmarking or when trie is empty
 	*/
-	bool removeUnusedNodes(Node& subNode);
+	bool removeUnusedNodes(NodeIndex& subNode);
 
 	/**
 	* \brief			Counts all the nodes being used
 	* \param  subNode	Which node we are counting
-	*		  count     Current count of nodes in subNode
-	* \return           Total amount of nodes
+	* \return           Total amount of nodes below subNode
+	*/
+	size_t countAllNodes(NodeIndex subNode) const;
+
+	/**
+	* \brief			Finds the nodes that lead to a word. Removed words
+	*					 leave nodes behind until unused nodes are removed
+	* \param  subNode	Node at the top of the subtree
+	* \return           One flag per node slot, set for subNode and the
+	*					 nodes below it that have a word end at or below them
+	*/
+	std::vector<bool> usedNodes(NodeIndex subNode) const;
+
+	/**
+	* \brief			Tells if a word ends at a node
+	* \param  subNode	Node being checked
+	* \return           true if a word ends at subNode. false otherwise
+	*/
+	bool isEndOfString(NodeIndex subNode) const;
+
+	/**
+	* \brief			Visits the subtree of a node depth first with an
+	*					 explicit stack, so any depth fits. Every operation
+	*					 that goes through whole subtrees is built on it
+	* \param  subNode	Node at the top of the subtree
+	*		  enter		Called as enter(key, child, depth) before going into
+	*					 each node below subNode, in key order. depth is 1
+	*					 for the children of subNode. Return false to skip
+	*					 the node and everything below it
+	*		  leave		Called as leave(node, depth, keys, children, count)
+	*					 after every child of a node is done, for subNode
+	*					 and every node entered. keys and children are
+	*					 copies taken when the node was entered, and node is
+	*					 its slot in its parent's copy, so leave can change
+	*					 both for the parent to see
+	* \return           subNode as leave left it
+	*/
+	template <typename Enter, typename Leave>
+	NodeIndex walkSubTrie(NodeIndex subNode, Enter enter, Leave leave) const;
+
+	/**
+	* \brief			Walks the nodes along a word
+	* \param  subNode	Node the walk starts at
+	*         word	    Word being followed. Its chars are in the alphabet
+	* \return           Node where word ends. ROOT if a char is missing,
+	*					 unless word is empty
+	*/
+	NodeIndex descend(NodeIndex subNode, std::string_view word) const;
+
+	/**
+	* \brief			Follows a chain of only children
+	* \param  subNode	First node of the chain
+	* \return           Last node of the chain. It has no children or several
+	*/
+	NodeIndex chainEnd(NodeIndex subNode) const;
+
+	/**
+	* \brief			Levels in the subtree of a node. A chain of only
+	*					 children counts as one level
+	* \param  subNode	Node at the top of the subtree
+	* \return           1 for a chain that ends without children
+	*/
+	size_t height(NodeIndex subNode) const;
+
+	/**
+	* \brief			Lists the top levels of a subtree in van Emde Boas
+	*					 order: the top half of the levels, then each subtree
+	*					 below it, each one laid out the same way. A chain of
+	*					 only children is kept in one run
+	* \param  subNode	Node at the top of the subtree
+	*		  levels	Levels of the subtree that are listed
+	*		  order		Gets the nodes
+	*		  below		Gets the children of the last listed level
+	*/
+	void vebOrder(NodeIndex subNode, size_t levels, std::vector<NodeIndex>& order,
+		std::vector<NodeIndex>& below) const;
+
+	/**
+	* \brief			Finds the first subtree with the same shape as a node's
+	* \param  subNode	Node at the top of the subtree
+	*		  canonical	Node each node is merged into. UNSEEN until known
+	*		  shapes	Node of each shape seen so far
+	* \return           Node subNode is merged into
+	*/
+	NodeIndex canonicalNode(NodeIndex subNode, std::vector<NodeIndex>& canonical,
+		std::unordered_map<std::string, NodeIndex>& shapes) const;
+
+	/**
+	* \brief			Copies the trie into a new arena in van Emde Boas order
+	* \param  canonical	Node each node is merged into. A node reached more
+	*					 than once is copied once, and then everything is frozen
+	*/
+	void rebuild(const std::vector<NodeIndex>& canonical);
+
+	/// Layouts of a child block, picked by how many children a node has.
+	///  Keys are alphabet indices. Kinds that would not be smaller than
+	///  DIRECT for the alphabet are skipped
+	enum Kind : uint8_t {
+		EMPTY, // no children and no block
+		INLINE, // up to INLINECHILDREN sorted keys and children inside the node. No block
+		NODE4, // up to 4 sorted keys followed by their children
+		NODE16, // up to 16 sorted keys followed by their children. SIMD search
+		BITMAP48, // 256 bit presence map, followed by up to 48 children in key order
+		DIRECT // one child per symbol of the alphabet
+	};
+
+	/**
+	* \brief			Looks for the child of a node that holds a key
+	* \param  subNode	Node whose children are searched
+	*         key       Alphabet index being looked for
+	* \return           Index of the child node. ROOT if there is no such child
+	*/
+	NodeIndex findChild(NodeIndex subNode, unsigned char key) const;
+
+	/**
+	* \brief			Creates a new node and links it as a child of a node
+	* \param  subNode	Node that gets the new child
+	*         key       Alphabet index the new child holds
+	* \return           Index of the new child node
+	* \note				Grows the block into the next kind when it is full
+	*/
+	NodeIndex addChild(NodeIndex subNode, unsigned char key);
+
+	/**
+	* \brief			Node that this trie may change. A shared node is
+	*					 copied along with its child block
+	* \param  subNode	Node about to change
+	* \return			subNode if it is not shared. Else its copy
+	*/
+	NodeIndex ownNode(NodeIndex subNode);
+
+	/**
+	* \brief			ownNode for a child. A copy replaces the child
+	* \param  subNode	Parent of child. Must not be shared
+	*		  key		Key of child
+	*		  child		Child about to change
+	* \return			Index of the child that may change
+	*/
+	NodeIndex ownChild(NodeIndex subNode, unsigned char key, NodeIndex child);
+
+	/**
+	* \brief			Calls visit(unsigned char, NodeIndex) on every child of a node
+	* \param  subNode	Node whose children are visited
+	*         visit     Called once per child with its alphabet index, in
+	*					 increasing order
 	*/
-	size_t countAllNodes(const Node& subNode, size_t count) const;
+	template <typename Visitor>
+	void forEachChild(NodeIndex subNode, Visitor visit) const;
+
+	/**
+	* \brief			Replaces the children of a node
+	* \param  subNode	Node whose block is rewritten
+	*         keys      Sorted alphabet indices of the new children
+	*         children  New children, one per key
+	*         count     Amount of children
+	*         kind      Layout to store them in. Must hold count children
+	* \note				A block of a different kind is taken from the end
+	*					 of blocks_. The old block is left unused
+	*/
+	void setChildren(NodeIndex subNode, const unsigned char* keys,
+		const NodeIndex* children, size_t count, Kind kind);
+
+	/**
+	* \brief			Gives out a node slot
+	* \return			Index of a default node. Reuses a freed slot if
+	*					 there is one, else grows nodes_
+	*/
+	NodeIndex newNode();
+
+	/**
+	* \brief			Gives out a zeroed block of a kind
+	* \param  kind		Kind of the block. Must not be EMPTY or INLINE
+	* \return			Offset of the block. Reuses a freed block of the
+	*					 same kind if there is one, else grows blocks_
+	*/
+	uint32_t allocateBlock(Kind kind);
+
+	/**
+	* \brief			Puts a block on the free list of its kind
+	* \param  block		Offset of the block
+	*         kind      Kind of the block. Does nothing for EMPTY and INLINE
+	*/
+	void releaseBlock(uint32_t block, Kind kind);
+
+	/**
+	* \brief			Checks that every char of a word is in the alphabet
+	* \param  word		Word being checked
+	* \return			false if a char of word is not in the alphabet
+	*/
+	static bool inAlphabet(std::string_view word);
+
+	/**
+	* \brief			Alphabet index of one symbol of a word
+	* \param  word		Word whose chars are in the alphabet
+	*         key       Position of the symbol. Symbol key % STEPS of
+	*					 char key / STEPS
+	* \return			Index of the symbol
+	*/
+	static unsigned char keyAt(std::string_view word, size_t key);
+
+	/**
+	* \brief			Turns the alphabet indices of symbols back into a word
+	* \param  keys		One char per symbol, holding its index
+	* \return			The word
+	*/
+	static std::string toWord(const std::string& keys);
+
+	/**
+	* \brief			Smallest kind that holds an amount of children
+	* \param  count		Amount of children
+	* \return			The kind
+	*/
+	static Kind kindFor(size_t count);
+
+	/**
+	* \brief			Kind a full block grows into
+	* \param  kind		Kind of the full block. Must not be DIRECT
+	* \return			The next kind the alphabet uses
+	*/
+	static Kind nextKind(Kind kind);
+
+	/**
+	* \brief			64 bits of a BITMAP48 presence map
+	* \param  bitmap	Presence map, 8 words of 32 bits
+	*         word      Which 64 bits. 0 holds keys 0 to 63
+	* \return			The bits, lowest key in the lowest bit
+	*/
+	static uint64_t bitmapWord(const uint32_t* bitmap, size_t word);
+
+	/**
+	* \brief			Rank of a key in a BITMAP48 presence map
+	* \param  bitmap	Presence map, 8 words of 32 bits
+	*         key       Key being ranked
+	* \return			Amount of keys below key that are present, which
+	*					 is the slot of key in the dense child array
+	*/
+	static size_t bitmapRank(const uint32_t* bitmap, size_t key);
+
+	friend class LoudsTrie; // LoudsTrie is encoded from the nodes directly
+	friend class FrozenTrie; // FrozenTrie is encoded from the nodes directly
 
 	/// NODE DECLARATION
 	struct Node {
@@ -158,16 +510,166 @@ private:
 		Node();
 
 	private:
-		friend class Trie; // Trie can see private data members
+		friend class BasicTrie; // BasicTrie can see private data members
 
 		bool endOfString_; // true if a node represents end of string. false otherwise
-		std::unordered_map<char, std::shared_ptr<Node> > children_; // map of children nodes
+		Kind kind_; // layout of the child block
+		uint16_t childCount_; // amount of children in use
+		unsigned char keys_[INLINECHILDREN]; // sorted keys of INLINE children
+		NodeIndex slots_[INLINECHILDREN]; // INLINE children. Otherwise slots_[0] is the offset
+										  //  in blocks_ of the child block, or the next free
+										  //  slot while on the free list
 	};
-	
+	static_assert(INLINECHILDREN >= 1 && INLINECHILDREN <= 4, "Inline children are meant for a few children");
+	static_assert(sizeof(Node) <= 8 + 5 * INLINECHILDREN, "BasicTrie::Node should have no extra padding");
+	static_assert(Alphabet::SIZE >= 1 && Alphabet::SIZE <= 256, "Alphabet keys must fit in a byte");
+
+	/// Index of the first root node. Also used to mean "no child" since no
+	///  node links back to a root
+	static const NodeIndex ROOT = 0;
+
+	/// Ends the free lists of blocks. Offset 0 is a real block
+	static const uint32_t NOBLOCK = UINT32_MAX;
+
+	/// Marks a node that was not reached yet while the trie is rebuilt
+	static const NodeIndex UNSEEN = UINT32_MAX;
+
+	/// Children a block of each kind holds, indexed by Kind
+	static const size_t CAPACITY[DIRECT + 1];
+
+	/// NodeIndex sized words taken by the keys (or bitmap) at the front of
+	///  a block, indexed by Kind
+	static const size_t KEYWORDS[DIRECT + 1];
+
+	/// Nodes and child blocks. Clones share one
+	struct Arena {
+		std::vector<Node> nodes_; // Node arena. nodes_[ROOT] is the first root node
+		std::vector<NodeIndex> blocks_; // Child arena. Holds the block of every node with children
+	};
+
+	/**
+	* \brief			Arena of every trie without words. Holds just a root
+	*					 and is never written, so tries share it until their
+	*					 first insert and moving one never allocates
+	* \return			The arena. Made by the first trie constructed
+	*/
+	static const std::shared_ptr<Arena>& emptyArena();
+
+	/**
+	* \brief			Swaps the empty arena for one this trie can write to
+	*/
+	void ownArena();
+
 	/// private data members
-	Node root_; // Root Node (empty node with children nodes that contain words)
+	std::shared_ptr<Arena> arena_; // Nodes and blocks. Shared with clones
+	NodeIndex root_; // Root node of this trie
+	NodeIndex frozenNodes_; // Nodes below this are shared and never change
+	NodeIndex freeNodes_; // First free node slot. Free slots link through slots_[0]. ROOT ends the list
+	uint32_t freeBlocks_[DIRECT + 1]; // First free block of each kind. Free blocks link through their first word
 	size_t size_; // Amount of words contained in the trie
 	size_t wordsRemoved_; // Amount of words that have been removed
+
+public:
+	/// COMPLETION RANGE DECLARATION
+	/// End of a CompletionIterator walk
+	class CompletionSentinel {
+	};
+
+	/// Input iterator that walks the words below a prefix depth first,
+	///  one word per increment, with an explicit stack of the nodes still
+	///  to visit
+	class CompletionIterator {
+	public:
+		typedef std::input_iterator_tag iterator_category;
+		typedef std::string value_type;
+		typedef std::ptrdiff_t difference_type;
+		typedef const std::string* pointer;
+		typedef const std::string& reference;
+
+		/**
+		* \brief Default Constructor. Already at the end
+		*/
+		CompletionIterator();
+
+		/**
+		* \brief			Current word
+		* \return			Word the iterator is at. Good until the next
+		*					 increment
+		*/
+		reference operator*() const;
+		pointer operator->() const;
+
+		/**
+		* \brief			Moves to the next word
+		* \return			This iterator
+		*/
+		CompletionIterator& operator++();
+		CompletionIterator operator++(int);
+
+		friend bool operator==(const CompletionIterator& i, CompletionSentinel) { return i.trie_ == nullptr; }
+		friend bool operator==(CompletionSentinel, const CompletionIterator& i) { return i.trie_ == nullptr; }
+		friend bool operator!=(const CompletionIterator& i, CompletionSentinel) { return i.trie_ != nullptr; }
+		friend bool operator!=(CompletionSentinel, const CompletionIterator& i) { return i.trie_ != nullptr; }
+
+	private:
+		friend class BasicTrie; // BasicTrie can see private data members
+		friend class Completions; // Completions starts the walk
+
+		/**
+		* \brief			Visits nodes until one ends a word
+		* \note				Ends the walk if the stack runs out
+		*/
+		void advance();
+
+		/// A node still to visit
+		struct Pending {
+			NodeIndex node_; // node being visited
+			unsigned char key_; // key of node
+			size_t depth_; // 1 for the children of the prefix node
+		};
+
+		const BasicTrie* trie_; // Trie being walked. nullptr at the end
+		std::vector<Pending> pending_; // Nodes still to visit. The next one is last
+		std::string keys_; // Keys of the path to the node visited last
+		size_t start_; // Keys of the prefix at the front of keys_
+		std::string word_; // Word of the current node
+	};
+
+	/// Words below a prefix as a range. Every begin starts a new walk
+	class Completions {
+	public:
+		/**
+		* \brief			Constructor
+		* \param  trie		Trie being walked
+		*		  prefix    Prefix that is being searched
+		*/
+		Completions(const BasicTrie& trie, std::string_view prefix);
+
+		/**
+		* \brief			Starts a walk
+		* \return			Iterator at the first word, or at the end if
+		*					 there is none
+		*/
+		CompletionIterator begin() const;
+
+		/**
+		* \brief			End of every walk
+		* \return			Sentinel
+		*/
+		CompletionSentinel end() const;
+
+	private:
+		const BasicTrie* trie_; // Trie being walked
+		std::string prefix_; // Prefix that is being searched
+	};
 };
 
+#include "trie-private.hpp"
+
+/// Trie of any chars
+typedef BasicTrie<ByteAlphabet> Trie;
+
+// compiled once in trie.cpp
+extern template class BasicTrie<ByteAlphabet>;
+
 #endif
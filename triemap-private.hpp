@@ -0,0 +1,321 @@
+/**
+* \file triemap-private.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for triemap.hpp. Included at the end of triemap.hpp
+*/
+#include <stdexcept> // length_error
+
+///////////////////////////////////////////////////////////////
+///////////// TrieMap Implementation //////////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename V>
+const typename TrieMap<V>::NodeIndex TrieMap<V>::ROOT;
+template <typename V>
+const uint32_t TrieMap<V>::NOVALUE;
+
+template <typename V>
+TrieMap<V>::TrieMap()
+	: nodes_(1, Node()), freeNodes_{ ROOT }, wordsRemoved_{ 0 }
+{
+	// nothing to do here
+}
+
+template <typename V>
+bool TrieMap<V>::insert(const std::string& key, V value)
+{
+	// walk down the key, adding the chars that are missing
+	NodeIndex subNode = ROOT;
+	for (auto i = key.begin(); i != key.end(); ++i) {
+		NodeIndex found = findChild(subNode, *i);
+		subNode = (found != ROOT) ? found : addChild(subNode, *i);
+	}
+
+	if (nodes_[subNode].value_ != NOVALUE) {
+		// key is there. replace its value
+		values_[nodes_[subNode].value_] = std::move(value);
+		return false;
+	}
+
+	// new key. its value goes at the end of the dense array
+	if (values_.size() >= NOVALUE) {
+		throw std::length_error("TrieMap has more values than a 32-bit id can address");
+	}
+	values_.push_back(std::move(value));
+	valueNodes_.push_back(subNode);
+	nodes_[subNode].value_ = static_cast<uint32_t>(values_.size() - 1);
+	return true;
+}
+
+template <typename V>
+V* TrieMap<V>::find(const std::string& key)
+{
+	NodeIndex found = descend(key);
+	return (found != ROOT || key.empty()) && nodes_[found].value_ != NOVALUE
+		? &values_[nodes_[found].value_] : nullptr;
+}
+
+template <typename V>
+const V* TrieMap<V>::find(const std::string& key) const
+{
+	NodeIndex found = descend(key);
+	return (found != ROOT || key.empty()) && nodes_[found].value_ != NOVALUE
+		? &values_[nodes_[found].value_] : nullptr;
+}
+
+template <typename V>
+bool TrieMap<V>::exists(const std::string& key) const
+{
+	return find(key) != nullptr;
+}
+
+template <typename V>
+std::vector<std::pair<std::string, V> > TrieMap<V>::prefix(const std::string& prefix) const
+{
+	std::vector<std::pair<std::string, V> > output;
+	NodeIndex found = descend(prefix);
+	if (found == ROOT && !prefix.empty()) {
+		// character not in map... no pairs
+		return output;
+	}
+
+	if (nodes_[found].value_ != NOVALUE) {
+		// prefix is a key itself
+		output.push_back(std::make_pair(prefix, values_[nodes_[found].value_]));
+	}
+	std::string currKey = prefix;
+	collectPairs(found, currKey, output);
+	return output;
+}
+
+template <typename V>
+bool TrieMap<V>::remove(const std::string& key)
+{
+	NodeIndex found = descend(key);
+	if ((found == ROOT && !key.empty()) || nodes_[found].value_ == NOVALUE) {
+		// key not in map
+		return false;
+	}
+
+	// move the last value into the hole so the array stays dense
+	uint32_t hole = nodes_[found].value_;
+	uint32_t last = static_cast<uint32_t>(values_.size() - 1);
+	if (hole != last) {
+		values_[hole] = std::move(values_[last]);
+		valueNodes_[hole] = valueNodes_[last];
+		nodes_[valueNodes_[hole]].value_ = hole;
+	}
+	values_.pop_back();
+	valueNodes_.pop_back();
+	nodes_[found].value_ = NOVALUE;
+	++wordsRemoved_;
+
+	// check if we need to remove unused nodes
+	if (wordsRemoved_ == MAXWORDSREMOVED) {
+		removeUnusedNodes(ROOT);
+		wordsRemoved_ = 0;
+	}
+	return true;
+}
+
+template <typename V>
+void TrieMap<V>::removeAll()
+{
+	nodes_ = std::vector<Node>(1, Node());
+	edges_ = std::vector<Edge>();
+	freeBlocks_ = EdgeBlock::FreeLists();
+	values_ = std::vector<V>();
+	valueNodes_ = std::vector<NodeIndex>();
+	freeNodes_ = ROOT;
+	wordsRemoved_ = 0;
+}
+
+template <typename V>
+size_t TrieMap<V>::size() const
+{
+	return values_.size();
+}
+
+template <typename V>
+bool TrieMap<V>::empty() const
+{
+	return values_.empty();
+}
+
+template <typename V>
+size_t TrieMap<V>::totalNodes() const
+{
+	return countAllNodes(ROOT);
+}
+
+template <typename V>
+size_t TrieMap<V>::memoryUsage() const
+{
+	return sizeof(TrieMap) + nodes_.capacity() * sizeof(Node) + edges_.capacity() * sizeof(Edge)
+		+ values_.capacity() * sizeof(V) + valueNodes_.capacity() * sizeof(NodeIndex);
+}
+
+template <typename V>
+typename TrieMap<V>::NodeIndex TrieMap<V>::descend(const std::string& key) const
+{
+	NodeIndex subNode = ROOT;
+	for (auto i = key.begin(); i != key.end(); ++i) {
+		subNode = findChild(subNode, *i);
+		if (subNode == ROOT) {
+			// character not in map
+			return ROOT;
+		}
+	}
+	return subNode;
+}
+
+template <typename V>
+typename TrieMap<V>::NodeIndex TrieMap<V>::findChild(NodeIndex subNode, char c) const
+{
+	const Node& node = nodes_[subNode];
+	size_t found = EdgeBlock::find(edges_, node.children_, node.childCount_, c);
+	return (found != edges_.size()) ? edges_[found].node_ : ROOT;
+}
+
+template <typename V>
+typename TrieMap<V>::NodeIndex TrieMap<V>::addChild(NodeIndex subNode, char c)
+{
+	// create the child first since it can move nodes_
+	NodeIndex child = newNode();
+
+	Node& node = nodes_[subNode];
+	EdgeBlock::insert(edges_, freeBlocks_, node.children_, node.childCount_, node.childCapacity_, Edge{ c, child });
+	return child;
+}
+
+template <typename V>
+typename TrieMap<V>::NodeIndex TrieMap<V>::newNode()
+{
+	if (freeNodes_ == ROOT) {
+		// no free nodes. grow the arena while indices stay below UINT32_MAX
+		if (nodes_.size() >= UINT32_MAX) {
+			throw std::length_error("TrieMap has more nodes than a NodeIndex can address");
+		}
+		nodes_.push_back(Node());
+		return static_cast<NodeIndex>(nodes_.size() - 1);
+	}
+
+	// take the first free node. its edge block went back to freeBlocks_
+	NodeIndex slot = freeNodes_;
+	freeNodes_ = nodes_[slot].value_;
+	nodes_[slot] = Node();
+	return slot;
+}
+
+template <typename V>
+void TrieMap<V>::collectPairs(NodeIndex subNode, std::string& currKey,
+	std::vector<std::pair<std::string, V> >& output) const
+{
+	// nodes still to visit. children go on last first so keys come out in order
+	struct Pending {
+		NodeIndex node_; // node being visited
+		char key_; // char of the edge into node_
+		size_t depth_; // length of the key of node_ below subNode
+	};
+	std::vector<Pending> pending;
+	size_t base = currKey.size();
+	NodeIndex node = subNode;
+	size_t depth = 0;
+	while (true) {
+		const Node& current = nodes_[node];
+		for (size_t i = current.children_ + current.childCount_; i != current.children_; --i) {
+			pending.push_back(Pending{ edges_[i - 1].node_, edges_[i - 1].key_, depth + 1 });
+		}
+		if (pending.empty()) {
+			break;
+		}
+
+		Pending next = pending.back();
+		pending.pop_back();
+		currKey.resize(base + next.depth_ - 1);
+		currKey.push_back(next.key_);
+		if (nodes_[next.node_].value_ != NOVALUE) {
+			output.push_back(std::make_pair(currKey, values_[nodes_[next.node_].value_]));
+		}
+		node = next.node_;
+		depth = next.depth_;
+	}
+	currKey.resize(base);
+}
+
+template <typename V>
+bool TrieMap<V>::removeUnusedNodes(NodeIndex subNode)
+{
+	// one frame per node on the path down from subNode. children are done
+	//  before their parent, which then keeps or frees each one
+	struct Frame {
+		NodeIndex node_; // node whose children are being checked
+		size_t next_; // edge of the next child to check
+		size_t kept_; // where the next kept edge goes
+	};
+	std::vector<Frame> frames = { Frame{ subNode, nodes_[subNode].children_, nodes_[subNode].children_ } };
+	while (true) {
+		Frame& frame = frames.back();
+		const Node& node = nodes_[frame.node_];
+		if (frame.next_ != node.children_ + node.childCount_) {
+			// go down into the next child
+			NodeIndex child = edges_[frame.next_].node_;
+			frames.push_back(Frame{ child, nodes_[child].children_, nodes_[child].children_ });
+			continue;
+		}
+
+		// every child is checked. keep the node if a child was kept
+		bool keepSubNode = frame.kept_ != node.children_;
+		nodes_[frame.node_].childCount_ = static_cast<uint16_t>(frame.kept_ - node.children_);
+		frames.pop_back();
+		if (frames.empty()) {
+			return keepSubNode;
+		}
+
+		Frame& parent = frames.back();
+		NodeIndex child = edges_[parent.next_].node_;
+		if (nodes_[child].value_ != NOVALUE || keepSubNode) {
+			edges_[parent.kept_] = edges_[parent.next_];
+			++parent.kept_;
+		}
+		else {
+			// child lost all of its children already. give it and its
+			//  edge block back
+			EdgeBlock::release(freeBlocks_, nodes_[child].children_, nodes_[child].childCapacity_);
+			nodes_[child].childCapacity_ = 0;
+			nodes_[child].value_ = freeNodes_;
+			freeNodes_ = child;
+		}
+		++parent.next_;
+	}
+}
+
+template <typename V>
+size_t TrieMap<V>::countAllNodes(NodeIndex subNode) const
+{
+	// every node below subNode is counted by its parent
+	size_t count = 0;
+	std::vector<NodeIndex> pending(1, subNode);
+	while (!pending.empty()) {
+		const Node& node = nodes_[pending.back()];
+		pending.pop_back();
+		count += node.childCount_;
+		for (size_t i = node.children_; i != node.children_ + node.childCount_; ++i) {
+			pending.push_back(edges_[i].node_);
+		}
+	}
+	return count;
+}
+
+///////////////////////////////////////////////////////////////
+///////////// Node Implementation /////////////////////////////
+///////////////////////////////////////////////////////////////
+
+template <typename V>
+TrieMap<V>::Node::Node()
+	: value_{ NOVALUE }, childCount_{ 0 }, childCapacity_{ 0 }, children_{ 0 }
+{
+	// nothing to do here
+}
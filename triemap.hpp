@@ -0,0 +1,216 @@
+/**
+* \file triemap.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for TrieMap, a trie that maps its words to values
+*
+*/
+
+// include gaurds
+#ifndef TRIEMAP_HPP_INCLUDED
+#define TRIEMAP_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <iostream>
+#include <cstdint>
+#include "trie.hpp" // MAXWORDSREMOVED
+#include "edgeblock.hpp"
+
+/// Trie that maps each key to a value. Nodes only hold the id of their
+///  value, and values are kept together in one dense array, so nodes
+///  without a value cost no more than they would in a set
+template <typename V>
+class TrieMap {
+private:
+	struct Node;
+	struct Edge;
+	typedef uint32_t NodeIndex; // position of a node inside nodes_
+public:
+	/**
+	* \brief Default Constructor to create an empty map
+	*/
+	TrieMap();
+
+	/**
+	* \brief			Sets the value of a key
+	* \param  key	    Key being set. The empty key is a key too
+	*         value     Value of key. Replaces the old one if key was there
+	* \return			true if key is new. false if its value was replaced
+	* \throws			std::length_error if the nodes or values no longer
+	*					 fit in 32-bit ids
+	*/
+	bool insert(const std::string& key, V value);
+
+	/**
+	* \brief			Looks up the value of a key
+	* \param  key	    Key being looked for
+	* \return			Pointer to the value. nullptr if key is not there
+	* \note				The pointer is good until the map changes
+	*/
+	V* find(const std::string& key);
+
+	/**
+	* \brief			Looks up the value of a key
+	* \param  key	    Key being looked for
+	* \return			Pointer to the value. nullptr if key is not there
+	* \note				The pointer is good until the map changes
+	*/
+	const V* find(const std::string& key) const;
+
+	/**
+	* \brief			Check if a key is in the map
+	* \param  key	    Key being checked
+	* \return			true if key has a value. false otherwise
+	*/
+	bool exists(const std::string& key) const;
+
+	/**
+	* \brief			Every key that starts with a prefix and its value
+	* \param  prefix    Prefix that is being searched
+	* \return			Pairs of key and value in key order. prefix itself
+	*					 comes first if it is a key
+	*/
+	std::vector<std::pair<std::string, V> > prefix(const std::string& prefix) const;
+
+	/**
+	* \brief			Remove a key and its value
+	* \param  key       Key being removed
+	* \return			true if key is removed from map. false otherwise
+	*/
+	bool remove(const std::string& key);
+
+	/**
+	* \brief			Remove all keys from map
+	*/
+	void removeAll();
+
+	/**
+	* \brief			Gives the size of the map
+	* \return			Amount of keys in map
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if map is empty
+	* \return			true if map is empty. false otherwise
+	* \note				Map can be empty but still have nodes.
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total mount of nodes in map
+	* \note             Root Node does not count as node.
+	*					Expensive call because it searches all nodes
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Bytes used by the map
+	* \return			Size of the map object plus its arenas and values
+	* \note				Counts reserved capacity, not only what is in use.
+	*					Memory a value owns itself is not counted
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Walks the nodes along a key
+	* \param  key	    Key being followed
+	* \return           Node where key ends. ROOT if a char is missing,
+	*					 unless key is empty
+	*/
+	NodeIndex descend(const std::string& key) const;
+
+	/**
+	* \brief			Looks for the child of a node that holds a char
+	* \param  subNode	Node whose children are searched
+	*         c         Char being looked for
+	* \return           Index of the child node. ROOT if there is no such child
+	*/
+	NodeIndex findChild(NodeIndex subNode, char c) const;
+
+	/**
+	* \brief			Creates a node and links it as a child of a node
+	* \param  subNode	Node that gets the new child
+	*         c         Char the new child holds
+	* \return           Index of the new child node
+	*/
+	NodeIndex addChild(NodeIndex subNode, char c);
+
+	/**
+	* \brief			Gives a node without children or value
+	* \return			Index of the node. Reuses a freed node and its edge
+	*					 block if there is one, else grows nodes_
+	*/
+	NodeIndex newNode();
+
+	/**
+	* \brief			Adds every key below a node and its value to output
+	* \param  subNode	Node whose keys are collected
+	*         currKey   Key spelled by the path to subNode
+	*		  output    A vector that gets the pairs
+	*/
+	void collectPairs(NodeIndex subNode, std::string& currKey,
+		std::vector<std::pair<std::string, V> >& output) const;
+
+	/**
+	* \brief			Remove Nodes that are not part of keys
+	* \param  subNode	Which node we are looking for unused keys
+	* \return           true if we should keep the subNode
+	*/
+	bool removeUnusedNodes(NodeIndex subNode);
+
+	/**
+	* \brief			Counts all the nodes being used
+	* \param  subNode	Which node we are counting
+	* \return           Total amount of nodes below subNode
+	*/
+	size_t countAllNodes(NodeIndex subNode) const;
+
+	/// NODE DECLARATION
+	struct Node {
+	public:
+		/**
+		* \brief Default Constructor
+		*/
+		Node();
+
+	private:
+		friend class TrieMap; // TrieMap can see private data members
+
+		uint32_t value_; // id of the value of the key that ends here. NOVALUE if
+						 //  none, or the next free node while on the free list
+		uint16_t childCount_; // amount of children in use
+		uint16_t childCapacity_; // amount of edges reserved for children
+		uint32_t children_; // offset in edges_ of the first child
+	};
+
+	/// EDGE DECLARATION
+	struct Edge {
+		char key_; // char held by the child
+		NodeIndex node_; // child node
+	};
+
+	/// Index of the root node. Also used to mean "no child" since no node
+	///  links back to the root
+	static const NodeIndex ROOT = 0;
+
+	/// Value id of a node that ends no key
+	static const uint32_t NOVALUE = UINT32_MAX;
+
+	/// private data members
+	std::vector<Node> nodes_; // Node arena. nodes_[ROOT] is the root node
+	std::vector<Edge> edges_; // Child arena. Each node owns a block sorted by key_
+	EdgeBlock::FreeLists freeBlocks_; // Blocks of edges_ no node uses
+	std::vector<V> values_; // Values, one per key, in no order
+	std::vector<NodeIndex> valueNodes_; // Node that holds each value
+	NodeIndex freeNodes_; // First free node. Free nodes link through value_ and have no edge block. ROOT ends the list
+	size_t wordsRemoved_; // Amount of keys that have been removed
+};
+
+#include "triemap-private.hpp"
+
+#endif
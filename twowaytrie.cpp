@@ -0,0 +1,118 @@
+/**
+* \file twowaytrie.cpp
+*
+* \author lhernandezcruz
+*
+* \brief Implemententation for twowaytrie.hpp
+*/
+#include "twowaytrie.hpp"
+#include <algorithm> // reverse
+
+///////////////////////////////////////////////////////////////
+///////////// TwoWayTrie Implementation ///////////////////////
+///////////////////////////////////////////////////////////////
+
+TwoWayTrie::TwoWayTrie()
+	: forward_{ Trie() }, backward_{ Trie() }
+{
+	// nothing to do here
+}
+
+void TwoWayTrie::insert(std::string word)
+{
+	// forward first. it throws before backward_ changes
+	std::string backward = reversed(word);
+	size_t before = forward_.size();
+	forward_.insert(word);
+	try {
+		backward_.insert(backward);
+	}
+	catch (...) {
+		// take back a word forward_ did not have so both hold the same words
+		if (forward_.size() != before) {
+			forward_.remove(word);
+		}
+		throw;
+	}
+}
+
+bool TwoWayTrie::exists(std::string word) const
+{
+	return forward_.exists(word);
+}
+
+std::vector<std::string> TwoWayTrie::restOfString(std::string prefix) const
+{
+	return forward_.restOfString(prefix);
+}
+
+std::vector<std::string> TwoWayTrie::endingWith(std::string suffix) const
+{
+	// a suffix is a prefix of the reversed words
+	std::vector<std::string> output = backward_.restOfString(reversed(suffix));
+	for (auto i = output.begin(); i != output.end(); ++i) {
+		std::reverse(i->begin(), i->end());
+	}
+	return output;
+}
+
+bool TwoWayTrie::remove(std::string word)
+{
+	std::string backward = reversed(word);
+	if (!forward_.remove(word)) {
+		// word not in trie
+		return false;
+	}
+	try {
+		backward_.remove(backward);
+	}
+	catch (...) {
+		// put the word back so both hold the same words
+		forward_.insert(word);
+		throw;
+	}
+	return true;
+}
+
+void TwoWayTrie::removeAll()
+{
+	forward_.removeAll();
+	backward_.removeAll();
+}
+
+size_t TwoWayTrie::size() const
+{
+	return forward_.size();
+}
+
+bool TwoWayTrie::empty() const
+{
+	return forward_.empty();
+}
+
+size_t TwoWayTrie::totalNodes() const
+{
+	return forward_.totalNodes() + backward_.totalNodes();
+}
+
+std::ostream& TwoWayTrie::showStatistics(std::ostream& out) const
+{
+	forward_.showStatistics(out);
+	return backward_.showStatistics(out);
+}
+
+std::ostream& TwoWayTrie::print(std::ostream& out) const
+{
+	return forward_.print(out);
+}
+
+size_t TwoWayTrie::memoryUsage() const
+{
+	return sizeof(TwoWayTrie) - 2 * sizeof(Trie) + forward_.memoryUsage() + backward_.memoryUsage();
+}
+
+std::string TwoWayTrie::reversed(std::string word)
+{
+	std::reverse(word.begin(), word.end());
+	return word;
+}
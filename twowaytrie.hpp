@@ -0,0 +1,130 @@
+/**
+* \file twowaytrie.hpp
+*
+* \author lhernandezcruz
+*
+* \brief Interface for TwoWayTrie, a trie that also finds words by their end
+*
+*/
+
+// include gaurds
+#ifndef TWOWAYTRIE_HPP_INCLUDED
+#define TWOWAYTRIE_HPP_INCLUDED 1
+
+#include <string>
+#include <vector>
+#include <iostream>
+#include "trie.hpp"
+
+/// Trie of words next to a Trie of the same words spelled backwards.
+///  insert and remove keep both up to date, so words that end with a
+///  suffix are found the same way restOfString finds words that start
+///  with a prefix. Same operations as Trie, plus endingWith
+class TwoWayTrie {
+public:
+	/**
+	* \brief Default Constructor to create an empty trie
+	*/
+	TwoWayTrie();
+
+	/**
+	* \brief			Insert a string into the trie
+	* \param  word	    Inserted word
+	* \note				If it throws, both tries are left as they were
+	*/
+	void insert(std::string word);
+
+	/**
+	* \brief			Check if a string exists in the trie
+	* \param  word	    Word being checked in the trie
+	* \return			true if word is in the trie. false otherwise
+	*/
+	bool exists(std::string word) const;
+
+	/**
+	* \brief			Tries to guess the rest of the string
+	* \param  prefix    Prefix that is being searched
+	* \return			A vector with strings in which the input is a prefix
+	*/
+	std::vector<std::string> restOfString(std::string prefix) const;
+
+	/**
+	* \brief			Tries to guess the start of the string
+	* \param  suffix    Suffix that is being searched
+	* \return			A vector with strings in which the input is a suffix.
+	*					 Sorted by their reversed spelling, so words that end
+	*					 the same way come out together
+	* \note				Like restOfString, suffix itself is not included
+	*/
+	std::vector<std::string> endingWith(std::string suffix) const;
+
+	/**
+	* \brief			Remove a string from the trie
+	* \param  word      Word being removed
+	* \return			true if word is removed from trie. false otherwise
+	* \note				If it throws, both tries still hold the word
+	*/
+	bool remove(std::string word);
+
+	/**
+	* \brief			Remove all strings from trie
+	*/
+	void removeAll();
+
+	/**
+	* \brief			Gives the size of the trie
+	* \return			Amount of strings in trie
+	*/
+	size_t size() const;
+
+	/**
+	* \brief			Tells user if Trie is empty
+	* \return			true if Trie is empty. false otherwise
+	* \note				Trie can be empty but still have nodes.
+	*/
+	bool empty() const;
+
+	/**
+	* \brief			Totol amount of nodes
+	* \return			Total mount of nodes in both tries
+	* \note             Root Nodes do not count as nodes.
+	*					Expensive call because it searches all nodes
+	*/
+	size_t totalNodes() const;
+
+	/**
+	* \brief			Print out Statistics of the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with statistics
+	* \note				Contains endl at end
+	*/
+	std::ostream& showStatistics(std::ostream& out) const;
+
+	/**
+	* \brief			Print out the words in the trie
+	* \param  out		Where to print Trie
+	* \return		    ostream with words in Trie
+	* \note				Contains endl at end
+	*/
+	std::ostream& print(std::ostream& out) const;
+
+	/**
+	* \brief			Bytes used by the trie
+	* \return			Size of the object plus both tries
+	* \note				Counts reserved capacity, not only what is in use
+	*/
+	size_t memoryUsage() const;
+private:
+	/**
+	* \brief			Spells a string backwards
+	* \param  word	    String being reversed
+	* \return			word from its last char to its first
+	*/
+	static std::string reversed(std::string word);
+
+	/// private data members
+	Trie forward_; // Words as they are spelled
+	Trie backward_; // Words spelled backwards
+};
+
+#endif